@@ -9,6 +9,9 @@
 //         github.com/Hintzelab/MABE/wiki/License
 
 #include "DefaultArchivist.h"
+
+#include "../Organism/OrganismPool.h"
+
 using namespace std;
 
 ////// ARCHIVIST-outputMethod is actually set by Modules.h //////
@@ -32,6 +35,8 @@ shared_ptr<ParameterLink<string>> DefaultArchivist::Arch_FilePrefixPL = Paramete
 shared_ptr<ParameterLink<bool>> DefaultArchivist::SS_Arch_writeDataFilesPL = Parameters::register_parameter("ARCHIVIST_DEFAULT-writeSnapshotDataFiles", false,
 	"if true, snapshot data files will be written (with all non genome data for entire population)");
 shared_ptr<ParameterLink<bool>> DefaultArchivist::SS_Arch_writeOrganismsFilesPL = Parameters::register_parameter("ARCHIVIST_DEFAULT-writeSnapshotOrganismsFiles", false, "if true, snapshot organisms files will be written (with all organisms for entire population)");
+shared_ptr<ParameterLink<string>> DefaultArchivist::Arch_organismsFormatPL = Parameters::register_parameter("ARCHIVIST-organismsFormat", (string) "text",
+	"format for genomes (and brains) in organisms files [text, binary, packed]. text is a readable list of sites, binary saves sites as encoded raw values, packed also packs each site into as few bits as the alphabet allows. files in all formats can be loaded");
 
 DefaultArchivist::DefaultArchivist(shared_ptr<ParametersTable> _PT, string _groupPrefix) :
 	PT(_PT), groupPrefix(_groupPrefix) {
@@ -55,6 +60,13 @@ DefaultArchivist::DefaultArchivist(shared_ptr<ParametersTable> _PT, string _grou
 
 	writeSnapshotDataFiles = SS_Arch_writeDataFilesPL->get(PT);
 	writeSnapshotGenomeFiles = SS_Arch_writeOrganismsFilesPL->get(PT);
+	organismsFormat = Arch_organismsFormatPL->get(PT);
+	countUniqueGenomes = AbstractGenome::shareIdenticalPL->get(PT);
+	writePoolStats = Global::organismPoolSizePL->get() > 0;
+	if (organismsFormat != "text" && organismsFormat != "binary" && organismsFormat != "packed") {
+		cout << "ARCHIVIST-organismsFormat \"" << organismsFormat << "\" is not defined. Use text, binary or packed.\nExiting." << endl;
+		exit(1);
+	}
 
 	realtimeSequence.push_back(0);
 	realtimeDataSequence.push_back(0);
@@ -138,59 +150,121 @@ DefaultArchivist::DefaultArchivist(vector<string> popFileColumns, string _maxDMV
 //save Max and pop file data
 //keys named all* will be converted to *. These should key for lists of values. These values will be averaged (used to average world repeats)
 void DefaultArchivist::writeRealTimeFiles(vector<shared_ptr<Organism>> &population) {
+	// only organisms older then now are saved (unless saveNewOrgs), the same organisms are used for both files
+	populationStats->start(population, [this](const shared_ptr<Organism>& org) {
+		return org->timeOfBirth < Global::update || saveNewOrgs;
+	});
+
 	// write out population data
 
 	if (writePopFile) {
-		double aveValue;
+		// each output behavior of a column is reduced to a single value, which is written as it's own column (i.e.
+		// score_AVE). columns are in the same order DataMap::writeToFile() would use for the lists of values
 		DataMap PopMap;
-
-
-		//for (auto key : DefaultPopFileColumns) {
-		//	if (key != "update") {
-		for (auto kv : uniqueColumnNameToOutputBehaviors) {
-			if (kv.first != "update") {
-				aveValue = 0;
-				for (auto org : population) {
-					if (org->timeOfBirth < Global::update || saveNewOrgs) {
-						PopMap.append(kv.first, org->dataMap.getAverage(kv.first));
-					}
+		map<string, vector<string>> columnNames; // columns for each key, by key
+		for (auto const& kv : uniqueColumnNameToOutputBehaviors) {
+			if (kv.first == "update" || populationStats->rowCount() == 0) {
+				continue;
+			}
+			DataMap::Key key = DataMap::getKey(kv.first);
+			int OB = kv.second;
+			vector<string>& names = columnNames[kv.first];
+			if (OB & DataMap::FIRST) {
+				names.push_back(kv.first);
+				PopMap.set(names.back(), populationStats->values(population, key)[0]);
+			}
+			if (OB & DataMap::AVE) {
+				names.push_back(kv.first + "_AVE");
+				PopMap.set(names.back(), populationStats->average(population, key));
+			}
+			if (OB & DataMap::VAR) {
+				names.push_back(kv.first + "_VAR");
+				PopMap.set(names.back(), populationStats->variance(population, key));
+			}
+			if (OB & DataMap::SUM) {
+				names.push_back(kv.first + "_SUM");
+				PopMap.set(names.back(), populationStats->sum(population, key));
+			}
+			if (OB & DataMap::PROD) {
+				cout << "  WARNING OUTPUT METHOD PROD IS HAS YET TO BE WRITTEN!" << endl;
+			}
+			if (OB & DataMap::STDERR) {
+				cout << "  WARNING OUTPUT METHOD STDERR IS HAS YET TO BE WRITTEN!" << endl;
+			}
+			if (OB & DataMap::LIST) {
+				names.push_back(kv.first + "_LIST");
+				string list = "\"[";
+				for (double value : populationStats->values(population, key)) {
+					list += to_string(value) + ",";
 				}
+				list.pop_back();
+				PopMap.set(names.back(), list + "]\"");
 			}
-			PopMap.setOutputBehavior(kv.first, kv.second);
 		}
 		PopMap.set("update", Global::update);
-		PopMap.writeToFile(PopFileName, { }); // write the PopMap to file with empty list (save all)
+		columnNames["update"] = { "update" };
+		if (countUniqueGenomes) {
+			int totalGenomes, uniqueGenomes;
+			countGenomes(population, totalGenomes, uniqueGenomes);
+			PopMap.set("totalGenomes", totalGenomes);
+			PopMap.set("uniqueGenomes", uniqueGenomes);
+			columnNames["totalGenomes"] = { "totalGenomes" };
+			columnNames["uniqueGenomes"] = { "uniqueGenomes" };
+		}
+		if (writePoolStats) { // totals since the start of the run (written as text, they may not fit in an int)
+			auto& poolStats = OrganismPool::stats();
+			PopMap.set("organismsAllocated", to_string(poolStats.made));
+			PopMap.set("organismsReused", to_string(poolStats.reused));
+			PopMap.set("organismsDeleted", to_string(poolStats.deleted));
+			columnNames["organismsAllocated"] = { "organismsAllocated" };
+			columnNames["organismsReused"] = { "organismsReused" };
+			columnNames["organismsDeleted"] = { "organismsDeleted" };
+		}
+		vector<string> columns;
+		for (auto const& kv : columnNames) {
+			columns.insert(columns.end(), kv.second.begin(), kv.second.end());
+		}
+		PopMap.writeToFile(PopFileName, columns);
 
 	}
 
 	// write out Max data
-	if (writeMaxFile && maxDMValue != "") {
-		double bestScore;
-		shared_ptr<Organism> bestOrg;
-		bool foundValid = false;
-		for (size_t i = 0; i < population.size(); i++) {
-			if (population[i]->timeOfBirth < Global::update || saveNewOrgs) { // if older then now or save new organisms (which were just born)
-				double newScore = population[i]->dataMap.getAverage(maxDMValue);
-				if (!foundValid) {
-					// this is the first vaid score we have found
-					foundValid = true;
-					bestScore = newScore;
-					bestOrg = population[i];
-				}
-				else { // this is not the first valid, see if it's best
-					if (newScore > bestScore) {
-						bestScore = newScore;
-						bestOrg = population[i];
-					}
-				}
-			}
-		}
+	int bestIndex = (writeMaxFile && maxDMValue != "") ? populationStats->maxIndex(population, DataMap::getKey(maxDMValue)) : -1;
+	if (bestIndex >= 0) {
+		auto bestOrg = population[bestIndex];
 		bestOrg->dataMap.set("update", Global::update);
 		bestOrg->dataMap.writeToFile(MaxFileName);
 		bestOrg->dataMap.clear("update");
 	}
 }
 
+// count the genomes of the organisms in the pop file, and how many of them have different content (see
+// AbstractGenome::sameContent()). genomes are only compared to genomes with the same contentHash(), and genomes which
+// do not have a content hash (0) are all counted as unique.
+void DefaultArchivist::countGenomes(vector<shared_ptr<Organism>> &population, int& totalGenomes, int& uniqueGenomes) {
+	unordered_map<size_t, vector<shared_ptr<AbstractGenome>>> uniqueByHash;
+	totalGenomes = 0;
+	uniqueGenomes = 0;
+	for (auto const& org : population) {
+		if (org->timeOfBirth >= Global::update && !saveNewOrgs) {
+			continue;
+		}
+		for (auto const& genome : org->genomes) {
+			totalGenomes++;
+			size_t hash = genome.second->contentHash();
+			if (hash == 0) {
+				uniqueGenomes++;
+				continue;
+			}
+			auto& sameHash = uniqueByHash[hash];
+			if (none_of(sameHash.begin(), sameHash.end(), [&genome](const shared_ptr<AbstractGenome>& other) { return genome.second->sameContent(other); })) {
+				sameHash.push_back(genome.second);
+				uniqueGenomes++;
+			}
+		}
+	}
+}
+
 void DefaultArchivist::saveSnapshotData(vector<shared_ptr<Organism>> population) {
 	// write out data
 	string dataFileName = DataFilePrefix + "_" + to_string(Global::update) + ".csv";
@@ -230,7 +304,8 @@ void DefaultArchivist::saveSnapshotData(vector<shared_ptr<Organism>> population)
 		//cout << endl;
 
 
-		if (org->snapshotAncestors.size() != 1 || org->snapshotAncestors.find(org->ID) == org->snapshotAncestors.end()) {
+		Lineage::Record& record = Lineage::at(org->lineage);
+		if (!record.snapshotAncestors.isOnly(org->ID)) {
 			// if this org does not only contain only itself in snapshotAncestors then it has not been saved before.
 			// we must confirm that snapshotAncestors is correct because things may have changed while we were not looking
 			// this process does 2 things:
@@ -244,39 +319,42 @@ void DefaultArchivist::saveSnapshotData(vector<shared_ptr<Organism>> population)
 			// unless they are atleast as old as the oldest org being saved to this file.
 			// if they are at least as old as the oldest org being saved to this file then we can simply append their ancestors
 
-			org->snapshotAncestors.clear();
-			vector<shared_ptr<Organism>> parentCheckList = org->parents;
+			vector<int> ancestorIDs;  // the new ancestors, made into snapshotAncestors once they are all found
+			vector<int> parentCheckList;  // Lineage records of parents to check
+			Lineage::forEachParent(org->lineage, [&parentCheckList](int p) {
+				parentCheckList.push_back(p);
+			});
 
 			while (parentCheckList.size() > 0) {
-				auto parent = parentCheckList.back(); // this is "this parent"
+				int parentIndex = parentCheckList.back(); // this is "this parent"
 				parentCheckList.pop_back(); // remove this parent from checklist
+				auto& parent = Lineage::at(parentIndex);
 
-				//cout << "\n org: " << org->ID << " parent: " << parent->ID << endl;
-				if (find(saveList.begin(), saveList.end(), parent) != saveList.end()) { // if this parent is being saved, they will serve as an ancestor
-					org->snapshotAncestors.insert(parent->ID);
+				//cout << "\n org: " << org->ID << " parent: " << parent.ID << endl;
+				if (find_if(saveList.begin(), saveList.end(), [parentIndex](const shared_ptr<Organism>& saved) { return saved->lineage == parentIndex; }) != saveList.end()) { // if this parent is being saved, they will serve as an ancestor
+					ancestorIDs.push_back(parent.ID);
 				}
 				else { // this parent is not being saved
-					if (parent->timeOfBirth < minBirthTime || (parent->snapshotAncestors.size() == 1 && parent->snapshotAncestors.find(parent->ID) != parent->snapshotAncestors.end())) {
+					if (parent.timeOfBirth < minBirthTime || parent.snapshotAncestors.isOnly(parent.ID)) {
 						// if this parent is old enough that it can not have a parent in the save list (and is not in save list),
 						// or this parent has self in it's ancestor list (i.e. it has already been saved to another file),
 						// copy ancestors from this parent
 						//cout << "getting ancestors for " << org->ID << " parent " << parent->ID << " is old enough or has self as ancestor..." << endl;
-						for (auto ancestorID : parent->snapshotAncestors) {
-							//cout << "adding from parent " << parent->ID << " ancestor " << ancestorID << endl;
-							org->snapshotAncestors.insert(ancestorID);
-						}
+						ancestorIDs.insert(ancestorIDs.end(), parent.snapshotAncestors.begin(), parent.snapshotAncestors.end());
 					}
 					else { // this parent not old enough (see if above), add this parents parents to check list (we need to keep looking)
-						for (auto p : parent->parents) {
+						Lineage::forEachParent(parentIndex, [&parentCheckList](int p) {
 							parentCheckList.push_back(p);
-						}
+						});
 					}
 				}
 			}
 
+			record.snapshotAncestors = AncestorSet(move(ancestorIDs));
+
 			/* // uncomment to see updated ancesstors list
 			cout << "  new snapshotAncestors List: ";
-			for (auto a : org->snapshotAncestors) {
+			for (auto a : record.snapshotAncestors) {
 				cout << a << "  ";
 			}
 			cout << endl;
@@ -297,14 +375,13 @@ void DefaultArchivist::saveSnapshotData(vector<shared_ptr<Organism>> population)
 		// now that we know that ancestor list is good for this org...
 		if (org->timeOfBirth < Global::update || saveNewOrgs) {
 			//cout << "  is being saved" << endl;
-			for (auto ancestorID : org->snapshotAncestors) {
+			for (auto ancestorID : record.snapshotAncestors) {
 				//cout << org->ID << " adding ancestor " << ancestorID << " to dataMap" << endl;
 				org->dataMap.append("snapshotAncestors", ancestorID);
 			}
 			org->dataMap.setOutputBehavior("snapshotAncestors", DataMap::LIST);
 
-			org->snapshotAncestors.clear();  // now that we have saved the ancestor data, set ancestors to self (so that others will inherit correctly)
-			org->snapshotAncestors.insert(org->ID);
+			record.snapshotAncestors = AncestorSet(org->ID);  // now that we have saved the ancestor data, set ancestors to self (so that others will inherit correctly)
 			org->dataMap.set("update", Global::update);
 			org->dataMap.setOutputBehavior("update", DataMap::FIRST);
 			org->dataMap.writeToFile(dataFileName, files["snapshotData"]);  // append new data to the file
@@ -315,24 +392,29 @@ void DefaultArchivist::saveSnapshotData(vector<shared_ptr<Organism>> population)
 	FileManager::closeFile(dataFileName); // since this is a snapshot, we will not be writting to this file again.
 }
 
+DataMap DefaultArchivist::serializeOrganism(shared_ptr<Organism> org) {
+	DataMap OrgMap;
+	OrgMap.set("ID", org->ID);
+	string tempName;
+
+	for (auto genome : org->genomes) {
+		tempName = "GENOME_" + genome.first;
+		OrgMap.merge(genome.second->serialize(tempName, organismsFormat));
+	}
+	for (auto brain : org->brains) {
+		tempName = "BRAIN_" + brain.first;
+		OrgMap.merge(brain.second->serialize(tempName, organismsFormat));
+	}
+	return OrgMap;
+}
+
 void DefaultArchivist::saveSnapshotOrganisms(vector<shared_ptr<Organism>> population) {
 	// write out organims
 	string organismFileName = OrganismFilePrefix + "_" + to_string(Global::update) + ".csv";
 
 	for (auto org : population) {
 		if (org->timeOfBirth < Global::update || saveNewOrgs) {
-			DataMap OrgMap;
-			OrgMap.set("ID", org->ID);
-			string tempName;
-
-			for (auto genome : org->genomes) {
-				tempName = "GENOME_" + genome.first;
-				OrgMap.merge(genome.second->serialize(tempName));
-			}
-			for (auto brain : org->brains) {
-				tempName = "BRAIN_" + brain.first;
-				OrgMap.merge(brain.second->serialize(tempName));
-			}
+			DataMap OrgMap = serializeOrganism(org);
 			OrgMap.writeToFile(organismFileName); // append new data to the file
 		}
 	}
@@ -367,39 +449,39 @@ bool DefaultArchivist::archive(vector<shared_ptr<Organism>> population, int flus
 			}
 		}
 
-		vector<shared_ptr<Organism>> toCheck;
-		unordered_set<shared_ptr<Organism>> checked;
+		vector<int> toCheck;  // Lineage records
+		unordered_set<int> checked;
 		int minBirthTime = population[0]->timeOfBirth; // time of birth of oldest org being saved in this update (init with random value)
 
 		for (auto org : population) {  // we don't need to worry about tracking parents or lineage, so we clear out this data every generation.
 			if (!writeSnapshotDataFiles) {
-				org->parents.clear();
+				Lineage::releaseParents(org->lineage);
 			}
-			else if (org->snapshotAncestors.find(org->ID) != org->snapshotAncestors.end()) { // if ancestors contains self, then this org has been saved and it's ancestor list has been collapsed
-				org->parents.clear();
-				checked.insert(org); // make a note, so we don't check this org later
+			else if (Lineage::at(org->lineage).snapshotAncestors.contains(org->ID)) { // if ancestors contains self, then this org has been saved and it's ancestor list has been collapsed
+				Lineage::releaseParents(org->lineage);
+				checked.insert(org->lineage); // make a note, so we don't check this org later
 				minBirthTime = min(org->timeOfBirth, minBirthTime);
 			}
 			else { // org has not ever been saved to file...
-				toCheck.push_back(org); // we will need to check to see if we can do clean up related to this org
-				checked.insert(org); // make a note, so we don't check twice
+				toCheck.push_back(org->lineage); // we will need to check to see if we can do clean up related to this org
+				checked.insert(org->lineage); // make a note, so we don't check twice
 				minBirthTime = min(org->timeOfBirth, minBirthTime);
 			}
 		}
 
 		while (toCheck.size() > 0) {
-			auto org = toCheck.back();
+			int index = toCheck.back();
 			toCheck.pop_back();
-			if (org->timeOfBirth < minBirthTime) { // no living org can be this orgs ancestor
-				org->parents.clear(); // we can safely release parents
+			if (Lineage::at(index).timeOfBirth < minBirthTime) { // no living org can be this orgs ancestor
+				Lineage::releaseParents(index); // we can safely release parents
 			}
 			else {
-				for (auto p : org->parents) { // we need to check parents (if any)
+				Lineage::forEachParent(index, [&](int p) { // we need to check parents (if any)
 					if (checked.find(p) == checked.end()) { // if parent is not already in checked list (i.e. either checked or going to be)
 						toCheck.push_back(p);
-						checked.insert(org); // make a note, so we don't check twice
+						checked.insert(index); // make a note, so we don't check twice
 					}
-				}
+				});
 			}
 		}
 
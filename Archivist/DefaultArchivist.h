@@ -20,6 +20,7 @@
 #include "../Global.h"
 #include "../Organism/Organism.h"
 #include "../Utilities/MTree.h"
+#include "../Group/PopulationStats.h"
 
 using namespace std;
 
@@ -39,6 +40,7 @@ class DefaultArchivist {
 	static shared_ptr<ParameterLink<string>> Arch_FilePrefixPL;  // name of the Data file
 	static shared_ptr<ParameterLink<bool>> SS_Arch_writeDataFilesPL;  // if true, write data file
 	static shared_ptr<ParameterLink<bool>> SS_Arch_writeOrganismsFilesPL;  // if true, write genome file
+	static shared_ptr<ParameterLink<string>> Arch_organismsFormatPL;  // format for genomes and brains in organisms files
 
 
 
@@ -64,8 +66,11 @@ class DefaultArchivist {
 	string OrganismFilePrefix;  // name of the Genome file (genomes on LOD)
 	bool writeSnapshotDataFiles;  // if true, write data file
 	bool writeSnapshotGenomeFiles;  // if true, write genome file
+	string organismsFormat;  // format for genomes and brains in organisms files (see AbstractGenome::serialize())
 
 	bool saveNewOrgs = false;
+	bool countUniqueGenomes;  // if true, uniqueGenomes and totalGenomes are written to the pop file (see GENOME-shareIdentical)
+	bool writePoolStats;  // if true, organismsAllocated, organismsReused and organismsDeleted are written to the pop file (see GLOBAL-organismPoolSize)
 
 	string groupPrefix;
 
@@ -82,9 +87,13 @@ class DefaultArchivist {
 
 	//save Max and average file data
 	void writeRealTimeFiles(vector<shared_ptr<Organism>> &population);
+	void countGenomes(vector<shared_ptr<Organism>> &population, int& totalGenomes, int& uniqueGenomes);
 
 	void saveSnapshotData(vector<shared_ptr<Organism>> population);
 
+	// ID and all genomes and brains of org, serialized with organismsFormat
+	DataMap serializeOrganism(shared_ptr<Organism> org);
+
 	//void saveSnapshotGenomes(vector<shared_ptr<Organism>> population);
 	void saveSnapshotOrganisms(vector<shared_ptr<Organism>> population);
 
@@ -99,4 +108,8 @@ class DefaultArchivist {
 
 	map<string, int> uniqueColumnNameToOutputBehaviors;
 
+	// values of the population for this update, the pop and max files are reductions over these (see writeRealTimeFiles()).
+	// shared with the Group, world and optimizer which write them
+	shared_ptr<PopulationStats> populationStats = make_shared<PopulationStats>();
+
 };
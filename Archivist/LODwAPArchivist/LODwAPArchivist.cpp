@@ -18,10 +18,66 @@ shared_ptr<ParameterLink<int>> LODwAPArchivist::LODwAP_Arch_pruneIntervalPL = Pa
 shared_ptr<ParameterLink<int>> LODwAPArchivist::LODwAP_Arch_terminateAfterPL = Parameters::register_parameter("ARCHIVIST_LODWAP-terminateAfter", 10, "how long to run after updates (to get allow time for coalescence)");
 shared_ptr<ParameterLink<bool>> LODwAPArchivist::LODwAP_Arch_writeDataFilePL = Parameters::register_parameter("ARCHIVIST_LODWAP-writeDataFile", true, "if true, a data file will be written");
 shared_ptr<ParameterLink<bool>> LODwAPArchivist::LODwAP_Arch_writeOrganismFilePL = Parameters::register_parameter("ARCHIVIST_LODWAP-writeOrganismsFile", true, "if true, an organisms file will be written");
+shared_ptr<ParameterLink<int>> LODwAPArchivist::LODwAP_Arch_organismsKeyframeIntervalPL = Parameters::register_parameter("ARCHIVIST_LODWAP-organismsKeyframeInterval", 0, "if > 0, genomes (and brains) in the organisms file are delta encoded: every organismsKeyframeInterval entries one entry is saved in full, the others are saved as edits to the previous entry. if 0, all entries are saved in full");
 shared_ptr<ParameterLink<string>> LODwAPArchivist::LODwAP_Arch_FilePrefixPL = Parameters::register_parameter("ARCHIVIST_LODWAP-filePrefix", (string) "NONE", "prefix for files saved by this archivst. \"NONE\" indicates no prefix.");
 
 
 
+// the organism with the Lineage record at index (which must have been kept, see archive())
+shared_ptr<Organism> LODwAPArchivist::keptOrganism(int index) {
+	if (!Lineage::at(index).kept) {
+		cout << "  ERROR :: in LODwAPArchivist::keptOrganism(), organism with ID " << Lineage::at(index).ID << " on the LOD was not kept.\n  Exiting." << endl;
+		exit(1);
+	}
+	return Lineage::at(index).kept;
+}
+
+// extend lineOfDescent to the current Most Recent Common Ancestor (MRCA). every living organism descends from the MRCA,
+// so while the MRCA has only one offspring, that offspring is the next MRCA. this gives the same MRCA as a search of the
+// LOD of population[0] (see Organism::getMostRecentCommonAncestor()), but the MRCA only moves when branches die, so an
+// update costs (amortized) one step rather then a walk of the LOD back to the last prune.
+void LODwAPArchivist::updateMRCA(const vector<shared_ptr<Organism>>& population) {
+	bool tracked = !lineOfDescent.empty() && Lineage::at(lineOfDescent.back()).ID == MRCA_ID;
+	while (tracked) {
+		int MRCA = lineOfDescent.back();
+		if (MRCA == population[0]->lineage || Lineage::at(MRCA).offspringCount > 1) {
+			break;
+		}
+		int offspring = Lineage::onlyOffspring(MRCA);
+		if (Lineage::at(MRCA).offspringCount == 1 && offspring != -1 && Lineage::at(offspring).parent == MRCA) {
+			lineOfDescent.push_back(offspring);
+		}
+		else {  // offspringCount and the offspring records disagree (i.e. after Organism::makeCopy()), search the LOD
+			tracked = false;
+		}
+	}
+	if (!tracked) {
+		lineOfDescent = population[0]->getLOD(population[0]);
+		int MRCA = population[0]->getMostRecentCommonAncestor(lineOfDescent);
+		lineOfDescent.resize(find(lineOfDescent.begin(), lineOfDescent.end(), MRCA) - lineOfDescent.begin() + 1);
+	}
+	MRCA_ID = Lineage::at(lineOfDescent.back()).ID;
+}
+
+// replace each string value in OrgMap (i.e. serialized genomes and brains) with the edits from the same value
+// in the last organism written, if that is shorter. if keyframe, nothing is replaced
+void LODwAPArchivist::deltaEncode(DataMap& OrgMap, bool keyframe) {
+	for (auto const& key : OrgMap.getKeys()) {
+		if (OrgMap.lookupDataMapTypeName(OrgMap.findKeyInData(key)) != "string") {
+			continue;
+		}
+		string value = OrgMap.getStringVector(key)[0];
+		auto previous = previousOrganismValues.find(key);
+		if (!keyframe && previous != previousOrganismValues.end()) {
+			string delta = BinaryCoding::toDelta(previous->second, value);
+			if (delta.size() < value.size()) {
+				OrgMap.set(key, delta);
+			}
+		}
+		previousOrganismValues[key] = value;
+	}
+}
+
 LODwAPArchivist::LODwAPArchivist(vector<string> popFileColumns, string _maxDMValue, shared_ptr<ParametersTable> _PT, string _groupPrefix) :
 		DefaultArchivist(popFileColumns, _maxDMValue, _PT, _groupPrefix) {
 
@@ -32,6 +88,8 @@ LODwAPArchivist::LODwAPArchivist(vector<string> popFileColumns, string _maxDMVal
 
 	writeDataFile = LODwAP_Arch_writeDataFilePL->get(PT);
 	writeOrganismFile = LODwAP_Arch_writeOrganismFilePL->get(PT);
+	organismsKeyframeInterval = LODwAP_Arch_organismsKeyframeIntervalPL->get(PT);
+	organismsWritten = 0;
 
 	dataSequence.push_back(0);
 	organismSequence.push_back(0);
@@ -73,6 +131,7 @@ LODwAPArchivist::LODwAPArchivist(vector<string> popFileColumns, string _maxDMVal
 	nextOrganismWrite = organismSequence[organismSeqIndex];
 
 	lastPrune = 0;
+	MRCA_ID = -1;
 
 }
 
@@ -108,6 +167,16 @@ bool LODwAPArchivist::archive(vector<shared_ptr<Organism>> population, int flush
 
 	}
 
+	// the LOD is kept as Lineage records. while an update has not been written, keep the organisms which may be
+	// written for it (the LOD member written for an update is in the population on or after that update)
+	if ((writeDataFile && nextDataWrite <= Global::update) || (writeOrganismFile && nextOrganismWrite <= Global::update)) {
+		for (auto org : population) {
+			Lineage::keep(org->lineage, org);
+		}
+	}
+
+	updateMRCA(population);
+
 	if ((Global::update % pruneInterval == 0) || (flush == 1)) {
 
 		if (files.find(DataFileName) == files.end()) {  // if file has not be initialized yet
@@ -119,26 +188,25 @@ bool LODwAPArchivist::archive(vector<shared_ptr<Organism>> population, int flush
 		}
 
 		// get the MRCA
-		vector<shared_ptr<Organism>> LOD = population[0]->getLOD(population[0]);  // get line of decent
-		shared_ptr<Organism> effective_MRCA;
-		shared_ptr<Organism> real_MRCA;
+		vector<int>& LOD = lineOfDescent;  // line of decent (Lineage records) from the last prune to the MRCA
+		int effective_MRCA;
+		int real_MRCA = lineOfDescent.back();
 		if (flush) {  // if flush then we don't care about coalescence
 			cout << "flushing LODwAP: using population[0] as Most Recent Common Ancestor (MRCA)" << endl;
-			effective_MRCA = population[0]->parents[0];  // this assumes that a population was created, but not tested at the end of the evolution loop!
-			real_MRCA = population[0]->getMostRecentCommonAncestor(LOD);  // find the convergance point in the LOD.
+			effective_MRCA = Lineage::at(population[0]->lineage).parent;  // this assumes that a population was created, but not tested at the end of the evolution loop!
+			LOD = population[0]->getLOD(population[0]);  // organisms after the MRCA will be written
 		} else {
-			effective_MRCA = population[0]->getMostRecentCommonAncestor(LOD);  // find the convergance point in the LOD.
-			real_MRCA = effective_MRCA;
+			effective_MRCA = real_MRCA;
 		}
 
 		// Save Data
 		int TTC;
 		if (writeDataFile) {
-			while ((effective_MRCA->timeOfBirth >= nextDataWrite) && (nextDataWrite <= Global::updatesPL->get())) {  // if there is convergence before the next data interval
-				shared_ptr<Organism> current = LOD[nextDataWrite - lastPrune];
+			while ((Lineage::at(effective_MRCA).timeOfBirth >= nextDataWrite) && (nextDataWrite <= Global::updatesPL->get())) {  // if there is convergence before the next data interval
+				shared_ptr<Organism> current = keptOrganism(LOD[nextDataWrite - lastPrune]);
 				current->dataMap.set("update", nextDataWrite);
 				current->dataMap.setOutputBehavior("update", DataMap::FIRST);
-				TTC = max(0, current->timeOfBirth - real_MRCA->timeOfBirth);
+				TTC = max(0, current->timeOfBirth - Lineage::at(real_MRCA).timeOfBirth);
 				current->dataMap.set("timeToCoalescence", TTC);
 				current->dataMap.setOutputBehavior("timeToCoalescence", DataMap::FIRST);
 				current->dataMap.writeToFile(DataFileName, files[DataFileName]);  // append new data to the file
@@ -159,24 +227,17 @@ bool LODwAPArchivist::archive(vector<shared_ptr<Organism>> population, int flush
 		//Save Organisms
 		if (writeOrganismFile) {
 
-			while ((effective_MRCA->timeOfBirth >= nextOrganismWrite) && (nextOrganismWrite <= Global::updatesPL->get())) {  // if there is convergence before the next data interval
+			while ((Lineage::at(effective_MRCA).timeOfBirth >= nextOrganismWrite) && (nextOrganismWrite <= Global::updatesPL->get())) {  // if there is convergence before the next data interval
 
-				shared_ptr<Organism> current = LOD[nextOrganismWrite - lastPrune];
+				shared_ptr<Organism> current = keptOrganism(LOD[nextOrganismWrite - lastPrune]);
 
-				DataMap OrgMap;
-				OrgMap.set("ID", current->ID);
+				DataMap OrgMap = serializeOrganism(current);
+				if (organismsKeyframeInterval > 0) {
+					deltaEncode(OrgMap, organismsWritten % organismsKeyframeInterval == 0);
+				}
+				organismsWritten++;
 				OrgMap.set("update", nextOrganismWrite);
 				OrgMap.setOutputBehavior("update", DataMap::FIRST);
-				string tempName;
-
-				for (auto genome : current->genomes) {
-					tempName = "GENOME_" + genome.first;
-					OrgMap.merge(genome.second->serialize(tempName));
-				}
-				for (auto brain : current->brains) {
-					tempName = "BRAIN_" + brain.first;
-					OrgMap.merge(brain.second->serialize(tempName));
-				}
 				OrgMap.writeToFile(OrganismFileName); // append new data to the file
 
 				if ((int) organismSequence.size() > organismSeqIndex + 1) {
@@ -189,8 +250,9 @@ bool LODwAPArchivist::archive(vector<shared_ptr<Organism>> population, int flush
 		}
 		// data and genomes have now been written out up till the MRCA
 		// so all data and genomes from before the MRCA can be deleted
-		effective_MRCA->parents.clear();
-		lastPrune = effective_MRCA->timeOfBirth;  // this will hold the time of the oldest genome in RAM
+		Lineage::releaseParents(effective_MRCA);
+		lastPrune = Lineage::at(effective_MRCA).timeOfBirth;  // this will hold the time of the oldest genome in RAM
+		LOD.erase(LOD.begin(), find(LOD.begin(), LOD.end(), effective_MRCA));  // the LOD now starts at the effective MRCA
 	}
 
 	// if we have reached the end of time OR we have pruned past updates (i.e. written out all data up to updates), then we ae done!
@@ -208,10 +270,10 @@ bool LODwAPArchivist::archive(vector<shared_ptr<Organism>> population, int flush
 
 	for (auto org : population) {  // we don't need to worry about tracking parents or lineage, so we clear out this data every generation.
 		if (!writeSnapshotDataFiles) {
-			org->parents.clear();
+			Lineage::releaseParents(org->lineage);
 		}
-		else if (org->snapshotAncestors.find(org->ID) != org->snapshotAncestors.end()) { // if ancestors contains self, then this org has been saved and it's ancestor list has been collapsed
-			org->parents.clear();
+		else if (Lineage::at(org->lineage).snapshotAncestors.contains(org->ID)) { // if ancestors contains self, then this org has been saved and it's ancestor list has been collapsed
+			Lineage::releaseParents(org->lineage);
 			checked.insert(org); // make a note, so we don't check this org later
 			minBirthTime = min(org->timeOfBirth, minBirthTime);
 		}
@@ -11,6 +11,7 @@
 #pragma once
 
 #include "../DefaultArchivist.h"
+#include "../../Utilities/BinaryCoding.h"
 
 using namespace std;
 
@@ -24,6 +25,7 @@ public:
 	static shared_ptr<ParameterLink<bool>> LODwAP_Arch_writeDataFilePL;  // if true, write data file
 	static shared_ptr<ParameterLink<bool>> LODwAP_Arch_writeOrganismFilePL;  // if true, write genome file
 
+	static shared_ptr<ParameterLink<int>> LODwAP_Arch_organismsKeyframeIntervalPL;  // if > 0, delta encode organisms with a full entry this often
 	static shared_ptr<ParameterLink<string>> LODwAP_Arch_FilePrefixPL;
 
 	vector<int> dataSequence;  // how often to write out data
@@ -34,8 +36,13 @@ public:
 	string OrganismFileName;  // name of the Genome file (genomes on LOD)
 	bool writeDataFile;  // if true, write data file
 	bool writeOrganismFile;  // if true, write genome file
+	int organismsKeyframeInterval;  // if > 0, delta encode organisms with a full entry this often
+	int organismsWritten;  // number of entries written to the organisms file
+	unordered_map<string, string> previousOrganismValues;  // string values of the last organism written (before delta encoding)
 
 	int lastPrune;  // last time Genome was Pruned
+	vector<int> lineOfDescent;  // Lineage records from the last prune to the Most Recent Common Ancestor (see updateMRCA())
+	int MRCA_ID;  // ID of the organism of lineOfDescent.back() (to check that the record has not been reused)
 
 	//// info about files under management
 	int nextDataWrite;  // next time data files will be written to disk
@@ -54,6 +61,10 @@ public:
 
 	virtual ~LODwAPArchivist() = default;
 
+	shared_ptr<Organism> keptOrganism(int index);
+	void updateMRCA(const vector<shared_ptr<Organism>>& population);
+	void deltaEncode(DataMap& OrgMap, bool keyframe);
+
 	virtual bool archive(vector<shared_ptr<Organism>> population, int flush = 0) override;
 
 	virtual bool isDataUpdate(int checkUpdate = -1) override;
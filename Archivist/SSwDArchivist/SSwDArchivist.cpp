@@ -171,6 +171,7 @@ bool SSwDArchivist::archive(vector<shared_ptr<Organism>> population, int flush)
 				if (saveNewOrgs || org->timeOfBirth < Global::update) { // if we are saving all orgs or this org is atleast 1 update old...
 					// ... checkpoint org
 					checkpoints[Global::update].push_back(org);
+					Lineage::keep(org->lineage, org);  // checkpoints do not keep organisms, keep it while it may have offspring
 					org->snapShotDataMaps[Global::update] = make_shared<DataMap>(org->dataMap);  // back up state of dataMap
 				}
 				if (Global::update == nextDataCheckPoint && Global::update <= Global::updatesPL->get()) {
@@ -178,7 +179,8 @@ bool SSwDArchivist::archive(vector<shared_ptr<Organism>> population, int flush)
 					// first we need to make sure that ancestor lists are up to date
 
 
-					if (org->ancestors.size() != 1 || org->ancestors.find(org->ID) == org->ancestors.end()) {
+					Lineage::Record& record = Lineage::at(org->lineage);
+					if (!record.ancestors.isOnly(org->ID)) {
 						// if this org does not only contain only itself in snapshotAncestors then it has not been saved before.
 						// we must confirm that snapshotAncestors is correct because things may have changed while we were not looking
 						// this process does 2 things:
@@ -192,39 +194,42 @@ bool SSwDArchivist::archive(vector<shared_ptr<Organism>> population, int flush)
 						// unless they are atleast as old as the oldest org being saved to this file.
 						// if they are at least as old as the oldest org being saved to this file then we can simply append their ancestors
 
-						org->ancestors.clear();
-						vector<shared_ptr<Organism>> parentCheckList = org->parents;
+						vector<int> ancestorIDs;  // the new ancestors, made into ancestors once they are all found
+						vector<int> parentCheckList;  // Lineage records of parents to check
+						Lineage::forEachParent(org->lineage, [&parentCheckList](int p) {
+							parentCheckList.push_back(p);
+						});
 
 						while (parentCheckList.size() > 0) {
-							auto parent = parentCheckList.back(); // this is "this parent"
+							int parentIndex = parentCheckList.back(); // this is "this parent"
 							parentCheckList.pop_back(); // remove this parent from checklist
+							auto& parent = Lineage::at(parentIndex);
 
-							//cout << "\n org: " << org->ID << " parent: " << parent->ID << endl;
-							if (find(saveList.begin(), saveList.end(), parent) != saveList.end()) { // if this parent is being saved, they will serve as an ancestor
-								org->ancestors.insert(parent->ID);
+							//cout << "\n org: " << org->ID << " parent: " << parent.ID << endl;
+							if (find_if(saveList.begin(), saveList.end(), [parentIndex](const shared_ptr<Organism>& saved) { return saved->lineage == parentIndex; }) != saveList.end()) { // if this parent is being saved, they will serve as an ancestor
+								ancestorIDs.push_back(parent.ID);
 							}
 							else { // this parent is not being saved
-								if (parent->timeOfBirth < minBirthTime || (parent->ancestors.size() == 1 && parent->ancestors.find(parent->ID) != parent->ancestors.end())) {
+								if (parent.timeOfBirth < minBirthTime || parent.ancestors.isOnly(parent.ID)) {
 									// if this parent is old enough that it can not have a parent in the save list (and is not in save list),
 									// or this parent has self in it's ancestor list (i.e. it has already been saved to another file),
 									// copy ancestors from this parent
 									//cout << "getting ancestors for " << org->ID << " parent " << parent->ID << " is old enough or has self as ancestor..." << endl;
-									for (auto ancestorID : parent->ancestors) {
-										//cout << "adding from parent " << parent->ID << " ancestor " << ancestorID << endl;
-										org->ancestors.insert(ancestorID);
-									}
+									ancestorIDs.insert(ancestorIDs.end(), parent.ancestors.begin(), parent.ancestors.end());
 								}
 								else { // this parent not old enough (see if above), add this parents parents to check list (we need to keep looking)
-									for (auto p : parent->parents) {
+									Lineage::forEachParent(parentIndex, [&parentCheckList](int p) {
 										parentCheckList.push_back(p);
-									}
+									});
 								}
 							}
 						}
 
+						record.ancestors = AncestorSet(move(ancestorIDs));
+
 						/* // uncomment to see updated ancesstors list
 						cout << "  new snapshotAncestors List: ";
-						for (auto a : org->snapshotAncestors) {
+						for (auto a : record.ancestors) {
 						cout << a << "  ";
 						}
 						cout << endl;
@@ -249,11 +254,10 @@ bool SSwDArchivist::archive(vector<shared_ptr<Organism>> population, int flush)
 
 
 					if (saveNewOrgs || org->timeOfBirth < Global::update) { // if this org is set up to be saved in this snapshot
-						for (auto ancestor : org->ancestors) {
+						for (auto ancestor : record.ancestors) {
 							org->snapShotDataMaps[Global::update].append("ancestors", ancestor);
 						}
-						org->ancestors.clear();  // clear ancestors (this data is safe in the checkPoint)
-						org->ancestors.insert(org->ID);  // now that we have saved the ancestor data, set ancestors to self (so that others will inherit correctly)
+						record.ancestors = AncestorSet(org->ID);  // now that we have saved the ancestor data, set ancestors to self (so that others will inherit correctly)
 														 // also, if this survives over intervals, it'll be pointing to self as ancestor in files (which is good)
 
 					}
@@ -300,18 +304,7 @@ bool SSwDArchivist::archive(vector<shared_ptr<Organism>> population, int flush)
 			while (index < checkpoints[nextOrganismWrite].size()) {
 				if (auto org = checkpoints[nextOrganismWrite][index].lock()) {  // this ptr is still good
 
-					DataMap OrgMap;
-					OrgMap.set("ID", org->ID);
-					string tempName;
-
-					for (auto genome : org->genomes) {
-						tempName = "GENOME_" + genome.first;
-						OrgMap.merge(genome.second->serialize(tempName));
-					}
-					for (auto brain : org->brains) {
-						tempName = "BRAIN_" + brain.first;
-						OrgMap.merge(brain.second->serialize(tempName));
-					}
+					DataMap OrgMap = serializeOrganism(org);
 					OrgMap.writeToFile(organismFileName); // append new data to the file
 					index++;
 				}
@@ -392,41 +385,43 @@ bool SSwDArchivist::archive(vector<shared_ptr<Organism>> population, int flush)
 	////////////////////////////////////////////////
 	//
 	////////////////////////////////////////////////
-	vector<shared_ptr<Organism>> toCheck;
-	unordered_set<shared_ptr<Organism>> checked;
+	vector<int> toCheck;  // Lineage records
+	unordered_set<int> checked;
 	int minBirthTime = population[0]->timeOfBirth; // time of birth of oldest org being saved in this update (init with random value)
 
 	for (auto org : population) {  // we don't need to worry about tracking parents or lineage, so we clear out this data every generation.
+		Lineage::Record& record = Lineage::at(org->lineage);
 		if (!writeSnapshotDataFiles && !writeDataFiles && !writeOrganismFiles) {
-			org->parents.clear();
+			Lineage::releaseParents(org->lineage);
 			//cout << "HERE?" << endl;
 		}
-		else if (org->snapshotAncestors.find(org->ID) != org->snapshotAncestors.end() && org->ancestors.find(org->ID) != org->ancestors.end() && (org->timeOfDeath < (Global::update - max(dataDelay, organismDelay)))) { // if ancestors and snapshotAncestors contains self, then this org has been saved and it's ancestor list has been collapsed
-			org->parents.clear();
-			checked.insert(org); // make a note, so we don't check this org later
+		else if (record.snapshotAncestors.contains(org->ID) && record.ancestors.contains(org->ID) && (org->timeOfDeath < (Global::update - max(dataDelay, organismDelay)))) { // if ancestors and snapshotAncestors contains self, then this org has been saved and it's ancestor list has been collapsed
+			Lineage::releaseParents(org->lineage);
+			checked.insert(org->lineage); // make a note, so we don't check this org later
 			minBirthTime = min(org->timeOfBirth, minBirthTime);
 		}
 		else { // org has not ever been saved to either snapshot_Data or SSwD_Data
-			toCheck.push_back(org); // we will need to check to see if we can do clean up related to this org
-			checked.insert(org); // make a note, so we don't check twice
+			toCheck.push_back(org->lineage); // we will need to check to see if we can do clean up related to this org
+			checked.insert(org->lineage); // make a note, so we don't check twice
 			minBirthTime = min(org->timeOfBirth, minBirthTime);
 		}
 	}
 
 	while (toCheck.size() > 0) {
-		auto org = toCheck.back();
+		int index = toCheck.back();
 		toCheck.pop_back();
-		if ((org->timeOfBirth < minBirthTime) && (org->timeOfDeath < (Global::update - max(dataDelay, organismDelay)))) { // no living org can be this orgs ancestor and this org died long enough ago that they can not be in a SSwD snapshot
-			//cout << "minBirthTime: " << minBirthTime << " org->timeOfBirth: " << org->timeOfBirth << " org->timeOfDeath: " << org->timeOfDeath << "max(dataDelay, organismDelay): " << max(dataDelay, organismDelay) << endl;
-			org->parents.clear(); // we can safely release parents
+		Lineage::Record& record = Lineage::at(index);
+		if ((record.timeOfBirth < minBirthTime) && (record.timeOfDeath < (Global::update - max(dataDelay, organismDelay)))) { // no living org can be this orgs ancestor and this org died long enough ago that they can not be in a SSwD snapshot
+			//cout << "minBirthTime: " << minBirthTime << " record.timeOfBirth: " << record.timeOfBirth << " record.timeOfDeath: " << record.timeOfDeath << "max(dataDelay, organismDelay): " << max(dataDelay, organismDelay) << endl;
+			Lineage::releaseParents(index); // we can safely release parents
 		}
 		else {
-			for (auto p : org->parents) { // we need to check parents (if any)
+			Lineage::forEachParent(index, [&](int p) { // we need to check parents (if any)
 				if (checked.find(p) == checked.end()) { // if parent is not already in checked list (i.e. either checked or going to be)
 					toCheck.push_back(p);
-					checked.insert(org); // make a note, so we don't check twice
+					checked.insert(index); // make a note, so we don't check twice
 				}
-			}
+			});
 		}
 	}
 	////////////////////////////////////////////////
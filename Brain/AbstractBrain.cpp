@@ -14,5 +14,7 @@
 shared_ptr<ParameterLink<string>> AbstractBrain::brainTypeStrPL = Parameters::register_parameter("BRAIN-brainType", (string) "This_string_is_set_by_modules.h", "This_string_is_set_by_modules.h");  // string parameter for outputMethod;
 ////// BRAIN-brainType is actually set by Modules.h //////
 
+shared_ptr<ParameterLink<bool>> AbstractBrain::reuseOnSilentMutationsPL = Parameters::register_parameter("BRAIN-reuseOnSilentMutations", true, "if true, brains which support it will reuse parts of the parent brain (rather then building everything from the genome) where the offspring genome's mutations did not change the sites used to build them");
+
 																																																					  //shared_ptr<ParameterLink<int>> AbstractBrain::hiddenNodesPL = Parameters::register_parameter("BRAIN-hiddenNodes", 8, "number of hidden nodes, if brain type supports hiden nodes");  // string parameter for outputMethod;
 //shared_ptr<ParameterLink<bool>> AbstractBrain::serialProcessingPL = Parameters::register_parameter("BRAIN-serialProcessing", false, "outputs from units will write to nodes, not nodesNext");
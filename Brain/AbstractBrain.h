@@ -26,6 +26,7 @@ using namespace std;
 class AbstractBrain {
 public:
 	static shared_ptr<ParameterLink<string>> brainTypeStrPL;
+	static shared_ptr<ParameterLink<bool>> reuseOnSilentMutationsPL;
 
 	const shared_ptr<ParametersTable> PT;
 
@@ -57,6 +58,10 @@ public:
 
 	virtual string description() = 0;  // returns a desription of this brain in it's current state
 	virtual DataMap getStats(string& prefix) = 0;  // returns a vector of string pairs of any stats that can then be used for data tracking (etc.)
+	// add the data from getStats() to dataMap. brains may override this to set their stats in dataMap directly
+	virtual void addStatsTo(DataMap& dataMap, string& prefix) {
+		dataMap.merge(getStats(prefix));
+	}
 	virtual string getType() {
 		cout << "ERROR! In AbstractBrain::getType()...\n This genome needs a getType function...\n  exiting.";
 		exit(1);
@@ -72,6 +77,12 @@ public:
 		return tempDataMap;
 	}
 
+	// convert a brain into data map using format (see AbstractGenome::serialize()). direct encoded brains which can save
+	// their data more compactly than text should override this. by default, all formats are the same as serialize(name)
+	virtual DataMap serialize(string& name, const string& format) {
+		return serialize(name);
+	}
+
 	// given an unordered_map<string, string> and PT, load data into this brain
 	virtual void deserialize(shared_ptr<ParametersTable> PT, unordered_map<string, string>& orgData, string& name) {
 		//cout << "ERROR! In AbstractBrain::deserialize(). This method has not been written for the type of brain use are using.\n  Exiting.";
@@ -181,6 +192,26 @@ public:
 //
 //	}
 
+	// returns true if update() is a pure function of (internal state, inputs). brains which
+	// return true must also provide getInternalState() and setInternalState() (see CachedBrain)
+	virtual bool isDeterministic() {
+		return false;
+	}
+
+	// append any state which is carried from one update to the next to state
+	virtual void getInternalState(vector<double>& state) {
+	}
+
+	// restore state as provided by getInternalState(), starting at state[0]
+	virtual void setInternalState(const vector<double>& state) {
+	}
+
+	// returns true if makeBrain() uses nothing but the content of the genomes, so that brains built from
+	// genomes with the same content (see AbstractGenome::sameContent()) are the same (see CachedBrain)
+	virtual bool isGenomeEncoded() {
+		return false;
+	}
+
 	virtual shared_ptr<AbstractBrain> makeCopy(shared_ptr<ParametersTable> _PT = nullptr) {
 		cout << "ERROR IN AbstractBrain::makeCopy() - You are using the abstract copy constructor for brains. You must define your own" << endl;
 		exit(1);
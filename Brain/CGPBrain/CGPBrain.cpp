@@ -83,13 +83,21 @@ CGPBrain::CGPBrain(int _nrInNodes, int _nrOutNodes, unordered_map<string, shared
 	auto handler = _genomes[genomeNamePL->get(PT)]->newHandler(_genomes[genomeNamePL->get(PT)]);
 	
 	if (buildModePL->get(PT) == "linear") {
+		auto genome = _genomes[genomeNamePL->get(PT)];
+		int numOps = numOpsPreVectorPL->get(PT);
+		genome->clearCodingSites();
 		for (int f = 0; f < (nrOutputTotal); f++) {
-			for (int i = 0; i < numOpsPreVectorPL->get(PT); i++) {
-				brainVectors[f].push_back(availableOps[handler->readInt(0, availableOpsCount - 1)]);
-				brainVectors[f].push_back(handler->readInt(0, nrInputTotal + (i)-1)); // num inputs + num new values - 1 since first is 0 -1 more to correct for 0 indexing
-				brainVectors[f].push_back(handler->readInt(0, nrInputTotal + (i)-1));
+			brainVectors[f].resize(3 * numOps);
+			for (int i = 0; i < numOps; i++) {
+				readInstruction(handler, f, i);
 			}
 		}
+		if (!genome->codingSites.empty() && !handler->atEOG()) {  // if reading wrapped past the end of the genome, instructions can not be located
+			codingSites = make_shared<vector<bool>>(move(genome->codingSites));
+			readStarts = make_shared<vector<int>>(move(genome->codingRegionStarts));
+		}
+		genome->codingSites.clear();  // stop tracking
+		genome->codingRegionStarts.clear();
 	}
 	else if (buildModePL->get(PT) == "codon") {
 #if CGPBRAIN_DEBUG == 1
@@ -254,6 +262,46 @@ CGPBrain::CGPBrain(int _nrInNodes, int _nrOutNodes, unordered_map<string, shared
 }
 
 
+// read instruction i of formula f from genome ("linear" buildMode). each instruction is it's own coding region
+void CGPBrain::readInstruction(shared_ptr<AbstractGenome::Handler> handler, int f, int i) {
+	int instruction = f * numOpsPreVectorPL->get(PT) + i;
+	brainVectors[f][3 * i] = availableOps[handler->readInt(0, availableOpsCount - 1, 0, instruction)];
+	brainVectors[f][3 * i + 1] = handler->readInt(0, nrInputTotal + (i)-1, 0, instruction); // num inputs + num new values - 1 since first is 0 -1 more to correct for 0 indexing
+	brainVectors[f][3 * i + 2] = handler->readInt(0, nrInputTotal + (i)-1, 0, instruction);
+}
+
+// in linear buildMode, if the offspring genome differs from the parent's only by point mutations, copy the parent
+// brain and reread only the instructions which were read from mutated sites
+shared_ptr<AbstractBrain> CGPBrain::makeBrainFrom(shared_ptr<AbstractBrain> parent, unordered_map<string, shared_ptr<AbstractGenome>>& _genomes) {
+	auto castParent = dynamic_pointer_cast<CGPBrain>(parent);
+	auto genome = _genomes[genomeNamePL->get(PT)];
+	if (!reuseOnSilentMutationsPL->get(PT) || castParent == nullptr || castParent->readStarts == nullptr ||
+			!genome->mutationLogValid || !genome->structuralLog.empty() || genome->countSites() != (int)castParent->codingSites->size()) {
+		return makeBrain(_genomes);
+	}
+	auto newBrain = dynamic_pointer_cast<CGPBrain>(castParent->makeCopy(PT));
+	auto handler = genome->newHandler(genome);
+	int numOps = numOpsPreVectorPL->get(PT);
+	auto const& starts = *castParent->readStarts;
+	auto const& parentCodingSites = *castParent->codingSites;
+	vector<int> mutatedSites = genome->mutationLog;
+	sort(mutatedSites.begin(), mutatedSites.end());
+	int lastInstruction = -1;
+	for (auto site : mutatedSites) {
+		if (!parentCodingSites[site]) {  // this site was not read
+			continue;
+		}
+		int instruction = (int)(upper_bound(starts.begin(), starts.end(), site) - starts.begin()) - 1;
+		if (instruction != lastInstruction) {
+			handler->resetHandler();
+			handler->advanceIndex(starts[instruction]);
+			newBrain->readInstruction(handler, instruction / numOps, instruction % numOps);
+			lastInstruction = instruction;
+		}
+	}
+	return newBrain;
+}
+
 void CGPBrain::resetBrain() {
 	//cout << "in reset Brain" << endl;
 	fill(inputValues.begin(), inputValues.end(), 0);
@@ -383,6 +431,30 @@ void CGPBrain::update() {
 	}
 }
 
+// a CGP brain is deterministic unless one of it's formulas uses RAND
+bool CGPBrain::isDeterministic() {
+	for (auto const& vec : brainVectors) {
+		for (int site = 0; site < (int)vec.size(); site += 3) {
+			if (vec[site] == 7) { // RAND
+				return false;
+			}
+		}
+	}
+	return true;
+}
+
+// readFromValues is rebuilt from inputs and writeToValues on each update, so writeToValues is all the state there is
+void CGPBrain::getInternalState(vector<double>& state) {
+	state.insert(state.end(), writeToValues.begin(), writeToValues.end());
+}
+
+void CGPBrain::setInternalState(const vector<double>& state) {
+	copy(state.begin(), state.begin() + writeToValues.size(), writeToValues.begin());
+	for (int index = 0; index < nrOutputValues; index++) {
+		outputValues[index] = writeToValues[index];
+	}
+}
+
 string CGPBrain::description() {
 	string S = "CGPBrain\n";
 	return S;
@@ -390,10 +462,14 @@ string CGPBrain::description() {
 
 DataMap CGPBrain::getStats(string& prefix) {
 	DataMap dataMap;
+	addStatsTo(dataMap, prefix);
+	return (dataMap);
+}
 
+void CGPBrain::addStatsTo(DataMap& dataMap, string& prefix) {
 	double aveFormulaLength = 0.0;
 	if (buildModePL->get(PT) == "codon") {
-		for (auto vec : brainVectors) {
+		for (auto const& vec : brainVectors) {
 			aveFormulaLength += (double)(vec.size());
 		}
 		aveFormulaLength /= double(brainVectors.size());
@@ -401,7 +477,6 @@ DataMap CGPBrain::getStats(string& prefix) {
 	}
 	// get stats
 	//cout << "warning:: getStats for CGPBrain needs to be written." << endl;
-	return (dataMap);
 }
 
 void CGPBrain::initializeGenomes(unordered_map<string, shared_ptr<AbstractGenome>>& _genomes) {
@@ -415,5 +490,7 @@ shared_ptr<AbstractBrain> CGPBrain::makeCopy(shared_ptr<ParametersTable> _PT)
 	}
 	auto newBrain = make_shared<CGPBrain>(nrInputValues, nrOutputValues, _PT);
 	newBrain->brainVectors = brainVectors;
+	newBrain->readStarts = readStarts;
+	newBrain->codingSites = codingSites;
 	return newBrain;
 }
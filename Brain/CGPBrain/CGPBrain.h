@@ -65,6 +65,10 @@ public:
 
 	vector<vector<int>> brainVectors; // instruction sets (op,in1,in2)
 
+	// coding regions tracked by the genome handler while this brain was built ("linear" buildMode only)
+	shared_ptr<vector<int>> readStarts; // genome site where each instruction was read
+	shared_ptr<vector<bool>> codingSites; // genome sites read to build this brain
+
 
 	CGPBrain() = delete;
 
@@ -80,6 +84,10 @@ public:
 		return newBrain;
 	}
 
+	void readInstruction(shared_ptr<AbstractGenome::Handler> handler, int f, int i);
+
+	virtual shared_ptr<AbstractBrain> makeBrainFrom(shared_ptr<AbstractBrain> parent, unordered_map<string, shared_ptr<AbstractGenome>>& _genomes) override;
+
 	virtual unordered_set<string> requiredGenomes() override {
 		return {genomeNamePL->get(PT) };
 	}
@@ -87,12 +95,20 @@ public:
 
 	virtual string description() override;
 	virtual DataMap getStats(string& prefix) override;
+	virtual void addStatsTo(DataMap& dataMap, string& prefix) override;
 	virtual string getType() override {
 		return "CGP";
 	}
 
 	virtual void resetBrain() override;
 
+	virtual bool isDeterministic() override;
+	virtual void getInternalState(vector<double>& state) override;
+	virtual void setInternalState(const vector<double>& state) override;
+	virtual bool isGenomeEncoded() override {
+		return true;
+	}
+
 	virtual shared_ptr<AbstractBrain> makeCopy(shared_ptr<ParametersTable> _PT = nullptr) override;
 	virtual void initializeGenomes(unordered_map<string, shared_ptr<AbstractGenome>>& _genomes);
 
@@ -0,0 +1,219 @@
+//  MABE is a product of The Hintze Lab @ MSU
+//     for general research information:
+//         hintzelab.msu.edu
+//     for MABE documentation:
+//         github.com/Hintzelab/MABE/wiki
+//
+//  Copyright (c) 2015 Michigan State University. All rights reserved.
+//     to view the full license, visit:
+//         github.com/Hintzelab/MABE/wiki/License
+
+#include <algorithm>
+
+#include "CachedBrain.h"
+
+shared_ptr<ParameterLink<bool>> CachedBrain::useCachePL = Parameters::register_parameter("BRAIN_CACHE-useCache", false, "if true, brains which report that they are deterministic will remember the results of updates and reuse them when the same internal state and inputs are seen again. brains which are recording activity (i.e. in visualize mode) are not cached");
+shared_ptr<ParameterLink<int>> CachedBrain::cacheSizePL = Parameters::register_parameter("BRAIN_CACHE-cacheSize", 1024, "maximum number of (state, inputs) entries remembered per brain. When the cache is full it is cleared.");
+shared_ptr<ParameterLink<int>> CachedBrain::buildCacheSizePL = Parameters::register_parameter("BRAIN_CACHE-buildCacheSize", 0, "if > 0, genome encoded brains are remembered keyed on the content of their genomes, and brains built from genomes with the same content are copied rather than built. This is the maximum number of brains remembered (for all brains in the run). When the cache is full it is cleared.");
+
+unordered_map<ParametersTable*, shared_ptr<CachedBrain::Counters>> CachedBrain::countersByPT;
+
+unordered_map<size_t, CachedBrain::BuiltBrain> CachedBrain::buildCache;
+
+CachedBrain::CachedBrain(shared_ptr<AbstractBrain> _brain, shared_ptr<ParametersTable> _PT) :
+	AbstractBrain(_brain->nrInputValues, _brain->nrOutputValues, _PT) {
+	brain = _brain;
+	cache = make_shared<CacheTable>();
+	deterministic = brain->isDeterministic();
+	useCache = useCachePL->get(PT);
+	cacheSize = cacheSizePL->get(PT);
+	buildCacheSize = brain->isGenomeEncoded() ? buildCacheSizePL->get(PT) : 0;
+	auto& ptCounters = countersByPT[PT.get()];
+	if (ptCounters == nullptr) {
+		ptCounters = make_shared<Counters>();
+	}
+	counters = ptCounters;
+
+	popFileColumns = brain->popFileColumns;
+	if (useCache) {
+		popFileColumns.push_back("brainCacheHitRate");
+	}
+	if (buildCacheSize > 0) {
+		popFileColumns.push_back("brainBuildCacheHits");
+		popFileColumns.push_back("brainBuildCacheMisses");
+	}
+}
+
+void CachedBrain::update() {
+	// while the wrapped brain is recording activity every update must run, or the record would miss steps
+	if (!useCache || !deterministic || brain->recordActivity) {
+		brain->inputValues = inputValues;
+		brain->update();
+		outputValues = brain->outputValues;
+		return;
+	}
+
+	if (counters->lookupsUpdate != Global::update) { // first lookup in a new update, start counting again
+		counters->lookupsUpdate = Global::update;
+		counters->lookups = 0;
+		counters->hits = 0;
+	}
+	counters->lookups++;
+
+	key.clear();
+	brain->getInternalState(key);
+	key.insert(key.end(), inputValues.begin(), inputValues.end());
+
+	auto entry = cache->find(key);
+	if (entry != cache->end()) {
+		counters->hits++;
+		brain->setInternalState(entry->second); // only the state part is read
+		copy(entry->second.end() - nrOutputValues, entry->second.end(), outputValues.begin());
+		copy(outputValues.begin(), outputValues.end(), brain->outputValues.begin());
+		return;
+	}
+
+	brain->inputValues = inputValues;
+	brain->update();
+	outputValues = brain->outputValues;
+
+	if ((int)cache->size() >= cacheSize) {
+		cache->clear();
+	}
+	nextState.clear();
+	brain->getInternalState(nextState);
+	nextState.insert(nextState.end(), outputValues.begin(), outputValues.end());
+	cache->emplace(key, nextState);
+}
+
+DataMap CachedBrain::getStats(string& prefix) {
+	DataMap dataMap;
+	addStatsTo(dataMap, prefix);
+	return dataMap;
+}
+
+void CachedBrain::addStatsTo(DataMap& dataMap, string& prefix) {
+	brain->addStatsTo(dataMap, prefix);
+	if (useCache) {
+		dataMap.set(prefix + "brainCacheHitRate", (counters->lookups > 0) ? (double)counters->hits / (double)counters->lookups : 0.0);
+	}
+	if (buildCacheSize > 0) {
+		dataMap.set(prefix + "brainBuildCacheHits", counters->lastBuildHits);
+		dataMap.set(prefix + "brainBuildCacheMisses", counters->lastBuildMisses);
+	}
+}
+
+shared_ptr<AbstractBrain> CachedBrain::findBuiltBrain(unordered_map<string, shared_ptr<AbstractGenome>>& _genomes, size_t& key) {
+	if (counters->buildsUpdate != Global::update) { // first build in a new update, keep the last totals and start counting again
+		counters->lastBuildHits = counters->buildHits;
+		counters->lastBuildMisses = counters->buildMisses;
+		counters->buildsUpdate = Global::update;
+		counters->buildHits = 0;
+		counters->buildMisses = 0;
+	}
+	auto names = brain->requiredGenomes();
+	vector<string> sortedNames(names.begin(), names.end());
+	sort(sortedNames.begin(), sortedNames.end());
+	key = hash<void*>()(PT.get()) ^ hash<string>()(brain->getType());
+	for (auto const& name : sortedNames) {
+		key ^= _genomes[name]->contentHash() + 0x9e3779b9 + (key << 6) + (key >> 2);
+	}
+	auto entry = buildCache.find(key);
+	if (entry != buildCache.end()) {
+		bool same = entry->second.genomes.size() == sortedNames.size();
+		for (size_t i = 0; same && i < sortedNames.size(); i++) {
+			same = _genomes[sortedNames[i]]->sameContent(entry->second.genomes[i]);
+		}
+		if (same) {
+			counters->buildHits++;
+			return entry->second.brain->makeCopy();
+		}
+	}
+	counters->buildMisses++;
+	return nullptr;
+}
+
+void CachedBrain::rememberBuiltBrain(size_t key, unordered_map<string, shared_ptr<AbstractGenome>>& _genomes, shared_ptr<AbstractBrain> newBrain) {
+	if ((int)buildCache.size() >= buildCacheSize) {
+		buildCache.clear();
+	}
+	auto names = brain->requiredGenomes();
+	vector<string> sortedNames(names.begin(), names.end());
+	sort(sortedNames.begin(), sortedNames.end());
+	BuiltBrain& entry = buildCache[key]; // replaces any brain with the same key
+	entry.genomes.clear();
+	for (auto const& name : sortedNames) {
+		entry.genomes.push_back(_genomes[name]);
+	}
+	entry.brain = newBrain->makeCopy(); // newBrain will be run (and maybe mutated), keep a clean copy
+}
+
+shared_ptr<AbstractBrain> CachedBrain::unwrap(shared_ptr<AbstractBrain> b) {
+	auto cached = dynamic_pointer_cast<CachedBrain>(b);
+	return (cached == nullptr) ? b : cached->brain;
+}
+
+shared_ptr<AbstractBrain> CachedBrain::makeBrain(unordered_map<string, shared_ptr<AbstractGenome>>& _genomes) {
+	if (buildCacheSize > 0) {
+		size_t key;
+		auto newBrain = findBuiltBrain(_genomes, key);
+		if (newBrain == nullptr) {
+			newBrain = brain->makeBrain(_genomes);
+			rememberBuiltBrain(key, _genomes, newBrain);
+		}
+		return make_shared<CachedBrain>(newBrain, PT);
+	}
+	return make_shared<CachedBrain>(brain->makeBrain(_genomes), PT);
+}
+
+// genome encoded brains are the same however they are built, so makeBrainFrom() can also use built brains
+shared_ptr<AbstractBrain> CachedBrain::makeBrainFrom(shared_ptr<AbstractBrain> parent, unordered_map<string, shared_ptr<AbstractGenome>>& _genomes) {
+	if (buildCacheSize > 0) {
+		size_t key;
+		auto newBrain = findBuiltBrain(_genomes, key);
+		if (newBrain == nullptr) {
+			newBrain = brain->makeBrainFrom(unwrap(parent), _genomes);
+			rememberBuiltBrain(key, _genomes, newBrain);
+		}
+		return make_shared<CachedBrain>(newBrain, PT);
+	}
+	return make_shared<CachedBrain>(brain->makeBrainFrom(unwrap(parent), _genomes), PT);
+}
+
+shared_ptr<AbstractBrain> CachedBrain::makeBrainFromMany(vector<shared_ptr<AbstractBrain>> parents, unordered_map<string, shared_ptr<AbstractGenome>>& _genomes) {
+	for (auto& p : parents) {
+		p = unwrap(p);
+	}
+	return make_shared<CachedBrain>(brain->makeBrainFromMany(parents, _genomes), PT);
+}
+
+void CachedBrain::mutate() {
+	brain->mutate();
+	// the brain may have changed, old results can not be trusted (and may be in use by copies)
+	cache = make_shared<CacheTable>();
+	deterministic = brain->isDeterministic();
+}
+
+void CachedBrain::resetBrain() {
+	AbstractBrain::resetBrain();
+	brain->resetBrain();
+}
+
+void CachedBrain::resetOutputs() {
+	AbstractBrain::resetOutputs();
+	brain->resetOutputs();
+}
+
+void CachedBrain::resetInputs() {
+	AbstractBrain::resetInputs();
+	brain->resetInputs();
+}
+
+shared_ptr<AbstractBrain> CachedBrain::makeCopy(shared_ptr<ParametersTable> _PT) {
+	if (_PT == nullptr) {
+		_PT = PT;
+	}
+	auto newBrain = make_shared<CachedBrain>(brain->makeCopy(_PT), _PT);
+	newBrain->cache = cache;
+	return newBrain;
+}
@@ -0,0 +1,159 @@
+//  MABE is a product of The Hintze Lab @ MSU
+//     for general research information:
+//         hintzelab.msu.edu
+//     for MABE documentation:
+//         github.com/Hintzelab/MABE/wiki
+//
+//  Copyright (c) 2015 Michigan State University. All rights reserved.
+//     to view the full license, visit:
+//         github.com/Hintzelab/MABE/wiki/License
+
+#pragma once
+
+#include <memory>
+#include <iostream>
+#include <unordered_map>
+#include <vector>
+
+#include "AbstractBrain.h"
+
+using namespace std;
+
+// CachedBrain wraps any other brain. If useCache is set and the wrapped brain reports that it is deterministic,
+// the result of each update (next internal state and outputs) is stored keyed on (internal state, inputs),
+// so that when a brain sees the same state and inputs again update() on the wrapped brain is not called.
+// Non-deterministic brains, and brains which are recording activity, are passed through unchanged.
+// If buildCacheSize > 0 and the wrapped brain is genome encoded, brains are also remembered (for the whole run)
+// keyed on the content of the genomes they were built from, and a new brain built from genomes with the same content
+// is copied from the remembered brain rather than built.
+class CachedBrain : public AbstractBrain {
+public:
+
+	static shared_ptr<ParameterLink<bool>> useCachePL;
+	static shared_ptr<ParameterLink<int>> cacheSizePL;
+	static shared_ptr<ParameterLink<int>> buildCacheSizePL;
+
+	// hash for (state, inputs) keys
+	struct KeyHash {
+		size_t operator()(const vector<double>& key) const {
+			size_t seed = key.size();
+			hash<double> hasher;
+			for (auto const& v : key) {
+				seed ^= hasher(v) + 0x9e3779b9 + (seed << 6) + (seed >> 2);
+			}
+			return seed;
+		}
+	};
+	// value is next state followed by outputs
+	typedef unordered_map<vector<double>, vector<double>, KeyHash> CacheTable;
+
+	// cache and build cache counts, kept for each PT (i.e. each brain name space) so that brains with different
+	// settings are not counted together.
+	// lookups and hits are counted for the current update. Organisms are born after evaluation, so their stats
+	// report on the evaluation that just finished.
+	// builds are counted for the current update, but offspring are born while their update's builds are still being
+	// counted, so their stats report the totals from the previous update, which are kept when the counts restart.
+	struct Counters {
+		int lookupsUpdate = -2;
+		long long lookups = 0;
+		long long hits = 0;
+		int buildsUpdate = -2;
+		int buildHits = 0;
+		int buildMisses = 0;
+		int lastBuildHits = 0; // totals from the last update with builds
+		int lastBuildMisses = 0;
+	};
+	static unordered_map<ParametersTable*, shared_ptr<Counters>> countersByPT;
+
+	// built brains, shared by all CachedBrains. the key is made from the genomes' contentHash(), the brain type and PT
+	struct BuiltBrain {
+		vector<shared_ptr<AbstractGenome>> genomes; // the genomes brain was built from (genomes are not changed once built)
+		shared_ptr<AbstractBrain> brain; // never used directly, only copied
+	};
+	static unordered_map<size_t, BuiltBrain> buildCache;
+
+	shared_ptr<AbstractBrain> brain; // the wrapped brain
+	shared_ptr<CacheTable> cache; // shared with copies of this brain, until either copy is mutated
+	shared_ptr<Counters> counters; // counters for PT
+	bool deterministic;
+	bool useCache;
+	int cacheSize;
+	int buildCacheSize;
+
+	vector<double> key;
+	vector<double> nextState;
+
+	CachedBrain() = delete;
+
+	CachedBrain(shared_ptr<AbstractBrain> _brain, shared_ptr<ParametersTable> _PT = nullptr);
+
+	virtual ~CachedBrain() = default;
+
+	virtual void update() override;
+
+	virtual string description() override {
+		return brain->description();
+	}
+	virtual DataMap getStats(string& prefix) override;
+	virtual void addStatsTo(DataMap& dataMap, string& prefix) override;
+	virtual string getType() override {
+		return brain->getType();
+	}
+
+	virtual DataMap serialize(string& name) override {
+		return brain->serialize(name);
+	}
+	virtual DataMap serialize(string& name, const string& format) override {
+		return brain->serialize(name, format);
+	}
+	virtual void deserialize(shared_ptr<ParametersTable> _PT, unordered_map<string, string>& orgData, string& name) override {
+		brain->deserialize(_PT, orgData, name);
+		cache = make_shared<CacheTable>();
+		deterministic = brain->isDeterministic();
+	}
+
+	virtual void initializeGenomes(unordered_map<string, shared_ptr<AbstractGenome>>& _genomes) override {
+		brain->initializeGenomes(_genomes);
+	}
+
+	virtual shared_ptr<AbstractBrain> makeBrain(unordered_map<string, shared_ptr<AbstractGenome>>& _genomes) override;
+	virtual shared_ptr<AbstractBrain> makeBrainFrom(shared_ptr<AbstractBrain> parent, unordered_map<string, shared_ptr<AbstractGenome>>& _genomes) override;
+	virtual shared_ptr<AbstractBrain> makeBrainFromMany(vector<shared_ptr<AbstractBrain>> parents, unordered_map<string, shared_ptr<AbstractGenome>>& _genomes) override;
+
+	virtual void mutate() override;
+
+	virtual void resetBrain() override;
+	virtual void resetOutputs() override;
+	virtual void resetInputs() override;
+
+	virtual void setRecordActivity(bool _recordActivity) override {
+		brain->setRecordActivity(_recordActivity);
+	}
+	virtual void setRecordFileName(string _recordActivityFileName) override {
+		brain->setRecordFileName(_recordActivityFileName);
+	}
+
+	virtual bool isDeterministic() override {
+		return deterministic;
+	}
+	virtual void getInternalState(vector<double>& state) override {
+		brain->getInternalState(state);
+	}
+	virtual void setInternalState(const vector<double>& state) override {
+		brain->setInternalState(state);
+	}
+
+	virtual shared_ptr<AbstractBrain> makeCopy(shared_ptr<ParametersTable> _PT = nullptr) override;
+
+	virtual unordered_set<string> requiredGenomes() override {
+		return brain->requiredGenomes();
+	}
+
+	// if b is a CachedBrain return the brain it wraps, otherwise return b
+	static shared_ptr<AbstractBrain> unwrap(shared_ptr<AbstractBrain> b);
+
+	// if a brain like the wrapped brain has been built from genomes with the same content, return a copy of it
+	// otherwise return nullptr. key is set for use with rememberBuiltBrain()
+	shared_ptr<AbstractBrain> findBuiltBrain(unordered_map<string, shared_ptr<AbstractGenome>>& _genomes, size_t& key);
+	void rememberBuiltBrain(size_t key, unordered_map<string, shared_ptr<AbstractGenome>>& _genomes, shared_ptr<AbstractBrain> newBrain);
+};
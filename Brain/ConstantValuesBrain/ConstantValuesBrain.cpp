@@ -31,36 +31,77 @@ ConstantValuesBrain::ConstantValuesBrain(int _nrInNodes, int _nrOutNodes, shared
 	}
 }
 
-shared_ptr<AbstractBrain> ConstantValuesBrain::makeBrain(unordered_map<string, shared_ptr<AbstractGenome>>& _genomes) {
-	shared_ptr<ConstantValuesBrain> newBrain = make_shared<ConstantValuesBrain>(nrInputValues, nrOutputValues,PT);
-	auto genomeHandler = _genomes[genomeNamePL->get(PT)]->newHandler(_genomes[genomeNamePL->get(PT)], true);
+// read samplesPerValue samples from genome and return their average. each value (index) is it's own coding region
+double ConstantValuesBrain::readValue(shared_ptr<AbstractGenome::Handler> genomeHandler, int index) {
 	auto samplesPerValue = samplesPerValuePL->get(PT);
 	auto valueType = valueTypePL->get(PT);
 	auto valueMin = valueMinPL->get(PT);
 	auto valueMax = valueMaxPL->get(PT);
 
-	double tempValue;
+	double tempValue = 0;
+	for (int j = 0; j < samplesPerValue; j++) {
+		if (valueType == 0) {
+			tempValue += (double)genomeHandler->readInt((int)valueMin, (int)valueMax, 0, index);
+		} else if (valueType == 1) {
+			tempValue += (double)genomeHandler->readDouble(valueMin, valueMax, 0, index);
+		} else {
+			cout << "  ERROR! BRAIN_CONSTANT-valueType is invalid. current value: " << valueType << endl;
+			exit(1);
+		}
+	}
+	if (valueType == 0) {
+		return int(tempValue / samplesPerValue);
+	}
+	return tempValue / samplesPerValue;
+}
+
+shared_ptr<AbstractBrain> ConstantValuesBrain::makeBrain(unordered_map<string, shared_ptr<AbstractGenome>>& _genomes) {
+	shared_ptr<ConstantValuesBrain> newBrain = make_shared<ConstantValuesBrain>(nrInputValues, nrOutputValues,PT);
+	auto genomeHandler = _genomes[genomeNamePL->get(PT)]->newHandler(_genomes[genomeNamePL->get(PT)], true);
 
+	auto genome = _genomes[genomeNamePL->get(PT)];
+	genome->clearCodingSites();
 	for (int i = 0; i < nrOutputValues; i++) {
-		tempValue = 0;
-		for (int j = 0; j < samplesPerValue; j++) {
-			if (valueType == 0) {
-				tempValue += (double)genomeHandler->readInt((int)valueMin, (int)valueMax);
-			} else if (valueType == 1) {
-				tempValue += (double)genomeHandler->readDouble(valueMin, valueMax);
-			} else {
-				cout << "  ERROR! BRAIN_CONSTANT-valueType is invalid. current value: " << valueType << endl;
-				exit(1);
-			}
-		}
-		if (valueType == 0) {
-			newBrain->outputValues[i] = int(tempValue / samplesPerValue);
+		newBrain->outputValues[i] = readValue(genomeHandler, i);
+	}
+	if (!genome->codingSites.empty() && !genomeHandler->atEOG()) {  // if reading wrapped past the end of the genome, values can not be located
+		newBrain->codingSites = make_shared<vector<bool>>(move(genome->codingSites));
+		newBrain->readStarts = make_shared<vector<int>>(move(genome->codingRegionStarts));
+	}
+	genome->codingSites.clear();  // stop tracking
+	genome->codingRegionStarts.clear();
+
+	return newBrain;
+}
+
+// if the offspring genome differs from the parent's only by point mutations, copy the parent brain and
+// reread only the values which were read from mutated sites
+shared_ptr<AbstractBrain> ConstantValuesBrain::makeBrainFrom(shared_ptr<AbstractBrain> parent, unordered_map<string, shared_ptr<AbstractGenome>>& _genomes) {
+	auto castParent = dynamic_pointer_cast<ConstantValuesBrain>(parent);
+	auto genome = _genomes[genomeNamePL->get(PT)];
+	if (!reuseOnSilentMutationsPL->get(PT) || castParent == nullptr || castParent->readStarts == nullptr ||
+			!genome->mutationLogValid || !genome->structuralLog.empty() || genome->countSites() != (int)castParent->codingSites->size()) {
+		return makeBrain(_genomes);
+	}
+	auto newBrain = dynamic_pointer_cast<ConstantValuesBrain>(castParent->makeCopy(PT));
+	auto genomeHandler = genome->newHandler(genome, true);
+	auto const& starts = *castParent->readStarts;
+	auto const& parentCodingSites = *castParent->codingSites;
+	vector<int> mutatedSites = genome->mutationLog;
+	sort(mutatedSites.begin(), mutatedSites.end());
+	int lastValue = -1;
+	for (auto site : mutatedSites) {
+		if (!parentCodingSites[site]) {  // this site was not read
+			continue;
 		}
-		if (valueType == 1) {
-			newBrain->outputValues[i] = tempValue / samplesPerValue;
+		int value = (int)(upper_bound(starts.begin(), starts.end(), site) - starts.begin()) - 1;
+		if (value != lastValue) {
+			genomeHandler->resetHandler();
+			genomeHandler->advanceIndex(starts[value]);
+			newBrain->outputValues[value] = readValue(genomeHandler, value);
+			lastValue = value;
 		}
 	}
-
 	return newBrain;
 }
 
@@ -158,6 +199,8 @@ shared_ptr<AbstractBrain> ConstantValuesBrain::makeCopy(shared_ptr<ParametersTab
 	for (int i = 0; i < nrOutputValues; i++) {
 		newBrain->outputValues[i] = outputValues[i];
 	}
+	newBrain->readStarts = readStarts;
+	newBrain->codingSites = codingSites;
 
 	return newBrain;
 }
\ No newline at end of file
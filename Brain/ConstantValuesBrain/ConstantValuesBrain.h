@@ -39,6 +39,10 @@ public:
 
 	static shared_ptr<ParameterLink<string>> genomeNamePL;
 
+	// coding regions tracked by the genome handler while this brain was built
+	shared_ptr<vector<int>> readStarts; // genome site where each value was read
+	shared_ptr<vector<bool>> codingSites; // genome sites read to build this brain
+
 	ConstantValuesBrain() = delete;
 
 	ConstantValuesBrain(int _nrInNodes, int _nrOutNodes, shared_ptr<ParametersTable> _PT = nullptr);
@@ -47,7 +51,10 @@ public:
 
 	virtual void update() override;
 
+	double readValue(shared_ptr<AbstractGenome::Handler> genomeHandler, int index);
+
 	virtual shared_ptr<AbstractBrain> makeBrain(unordered_map<string, shared_ptr<AbstractGenome>>& _genomes) override;
+	virtual shared_ptr<AbstractBrain> makeBrainFrom(shared_ptr<AbstractBrain> parent, unordered_map<string, shared_ptr<AbstractGenome>>& _genomes) override;
 
 	virtual unordered_set<string> requiredGenomes() override {
 		return { genomeNamePL->get(PT) };
@@ -62,6 +69,10 @@ public:
 	virtual void resetBrain() override;
 	virtual void resetOutputs() override;
 
+	virtual bool isGenomeEncoded() override {
+		return true;
+	}
+
 	virtual shared_ptr<AbstractBrain> makeCopy(shared_ptr<ParametersTable> _PT = nullptr) override;
 
 	virtual void initializeGenomes(unordered_map<string, shared_ptr<AbstractGenome>>& _genomes);
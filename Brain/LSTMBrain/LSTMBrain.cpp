@@ -153,6 +153,21 @@ void inline LSTMBrain::resetOutputs() {
     }
 }
 
+// state is the cell values (C) followed by the last outputs (H)
+void LSTMBrain::getInternalState(vector<double>& state) {
+    state.insert(state.end(), C.begin(), C.end());
+    state.insert(state.end(), H.begin(), H.end());
+}
+
+void LSTMBrain::setInternalState(const vector<double>& state) {
+    for(int o=0;o<_O;o++){
+        C[o]=state[o];
+        H[o]=state[_O+o];
+        X[o+_I]=H[o];
+        outputValues[o]=H[o];
+    }
+}
+
 string LSTMBrain::description() {
 	string S = "LSTM Brain";
 	return S;
@@ -58,6 +58,15 @@ public:
 	virtual void resetBrain() override;
 	virtual void resetOutputs() override;
 
+	virtual bool isDeterministic() override {
+		return true;
+	}
+	virtual bool isGenomeEncoded() override {
+		return true;
+	}
+	virtual void getInternalState(vector<double>& state) override;
+	virtual void setInternalState(const vector<double>& state) override;
+
 	virtual void initializeGenomes(unordered_map<string, shared_ptr<AbstractGenome>>& _genomes) override;
     
     double fastSigmoid(double value){
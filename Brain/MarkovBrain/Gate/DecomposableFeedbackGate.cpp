@@ -65,6 +65,7 @@ DecomposableFeedbackGate::DecomposableFeedbackGate(pair<vector<int>, vector<int>
       }
   }
   originalTable = table; // initial copy
+  originalFactors = factors; // feedback changes factors, resetGate() restores them
 
   chosenInPos.clear();
   chosenInNeg.clear();
@@ -218,6 +219,7 @@ void DecomposableFeedbackGate::resetGate() {
   for (size_t i = 0; i < table.size(); i++)
     for (size_t j = 0; j < table[i].size(); j++)
       table[i][j] = originalTable[i][j];
+  factors = originalFactors;
     string temp;
 }
 
@@ -298,12 +300,17 @@ shared_ptr<AbstractGate> DecomposableFeedbackGate::makeCopy(shared_ptr<Parameter
 	}
 	auto newGate = make_shared<DecomposableFeedbackGate>(_PT);
 	newGate->table = originalTable; // non-Lamarkian
-    originalTable = originalTable;
-    feedbackON = feedbackON;
-    posFBNode = posFBNode;
-    negFBNode = negFBNode;
-    posLevelOfFB = posLevelOfFB;
-    negLevelOfFB = negLevelOfFB;
+	newGate->originalTable = originalTable;
+	newGate->posFBNode = posFBNode;
+	newGate->negFBNode = negFBNode;
+	newGate->nrPos = nrPos;
+	newGate->nrNeg = nrNeg;
+	newGate->posLevelOfFB = posLevelOfFB;
+	newGate->negLevelOfFB = negLevelOfFB;
+	newGate->factors = originalFactors; // non-Lamarkian
+	newGate->originalFactors = originalFactors;
+	newGate->ins = ins;
+	newGate->outs = outs;
 	newGate->ID = ID;
 	newGate->inputs = inputs;
 	newGate->outputs = outputs;
@@ -29,6 +29,7 @@ class DecomposableFeedbackGate : public AbstractGate {
   vector<vector<double>> table;
   vector<vector<double>> originalTable;
   vector<vector<double>> factors;
+  vector<vector<double>> originalFactors;
   int ins,outs;
   DecomposableFeedbackGate() = delete;
   DecomposableFeedbackGate(shared_ptr<ParametersTable> _PT = nullptr) :
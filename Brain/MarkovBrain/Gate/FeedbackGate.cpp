@@ -251,12 +251,13 @@ shared_ptr<AbstractGate> FeedbackGate::makeCopy(shared_ptr<ParametersTable> _PT)
 	}
 	auto newGate = make_shared<FeedbackGate>(_PT);
 	newGate->table = originalTable; // non-Lamarkian
-    originalTable = originalTable;
-    feedbackON = feedbackON;
-    posFBNode = posFBNode;
-    negFBNode = negFBNode;
-    posLevelOfFB = posLevelOfFB;
-    negLevelOfFB = negLevelOfFB;
+	newGate->originalTable = originalTable;
+	newGate->posFBNode = posFBNode;
+	newGate->negFBNode = negFBNode;
+	newGate->nrPos = nrPos;
+	newGate->nrNeg = nrNeg;
+	newGate->posLevelOfFB = posLevelOfFB;
+	newGate->negLevelOfFB = negLevelOfFB;
 	newGate->ID = ID;
 	newGate->inputs = inputs;
 	newGate->outputs = outputs;
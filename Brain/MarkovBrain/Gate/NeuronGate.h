@@ -83,6 +83,11 @@ public:
 
 		thresholdFromNode = _thresholdFromNode;
 		deliveryChargeFromNode = _deliveryChargeFromNode;
+
+		defaultThresholdMin = defaultThresholdMinPL->get(PT);
+		defaultThresholdMax = defaultThresholdMaxPL->get(PT);
+		defaultDeliveryChargeMin = defaultDeliveryChargeMinPL->get(PT);
+		defaultDeliveryChargeMax = defaultDeliveryChargeMaxPL->get(PT);
 	}
 
 	virtual ~NeuronGate() = default;
@@ -49,14 +49,9 @@ shared_ptr<ParameterLink<int>> Gate_Builder::bitsPerCodonPL = Parameters::regist
 
 // Gets "howMany" addresses, advances the genome_index buy "howManyMax" addresses and updates "codingRegions" with the addresses being used.
 void Gate_Builder::getSomeBrainAddresses(const int& howMany, const int& howManyMax, vector<int>& addresses, shared_ptr<AbstractGenome::Handler> genomeHandler, int code, int gateID, shared_ptr<ParametersTable> _PT) {
-	int i;
-	for (i = 0; i < howMany; i++) {  // for the number of addresses we need
-		addresses[i] = genomeHandler->readInt(0, (1 << bitsPerBrainAddressPL->get(_PT)) - 1, code, gateID);  // get an address
-	}
-	while (i < howManyMax) { // leave room in the genome in case this gate gets more IO later
-		genomeHandler->readInt(0, (1 << bitsPerBrainAddressPL->get(_PT)) - 1);
-		i++;
-	}
+	int addressMax = (1 << bitsPerBrainAddressPL->get(_PT)) - 1;
+	genomeHandler->readInts(addresses.data(), howMany, 0, addressMax, code, gateID);  // get the addresses we need
+	genomeHandler->skipInts(howManyMax - howMany, 0, addressMax);  // leave room in the genome in case this gate gets more IO later
 }
 
 // given a genome and a genomeIndex:
@@ -518,14 +513,14 @@ void Gate_Builder::setupGates() {
 			int maxIn, maxOut;
 			pair<vector<int>,vector<int>> addresses = getInputsAndOutputs(IO_Ranges, maxIn, maxOut, genomeHandler, gateID, _PT, "BRAIN_MARKOV_GATES_FEEDBACK");
 			vector<vector<int>> rawTable = genomeHandler->readTable( {1 << addresses.first.size(), 1 << addresses.second.size()}, {(int)pow(2,maxIn), (int)pow(2,maxOut)}, {0, 255}, AbstractGate::DATA_CODE, gateID);
-            posFBNode = genomeHandler->readInt(0,255); // we will scale to, say, 256 and floor later.
-            negFBNode = genomeHandler->readInt(0,255);
-            nrPos = genomeHandler->readInt(0,3);
-            nrNeg = genomeHandler->readInt(0,3);
+            posFBNode = genomeHandler->readInt(0,255, AbstractGate::IN_ADDRESS_CODE, gateID); // we will scale to, say, 256 and floor later.
+            negFBNode = genomeHandler->readInt(0,255, AbstractGate::IN_ADDRESS_CODE, gateID);
+            nrPos = genomeHandler->readInt(0,3, AbstractGate::DATA_CODE, gateID);
+            nrNeg = genomeHandler->readInt(0,3, AbstractGate::DATA_CODE, gateID);
             posLevelOfFB.resize(nrPos);
             negLevelOfFB.resize(nrNeg);
-            for (int i=0; i<nrPos; i++) posLevelOfFB[i] = genomeHandler->readDouble(0,256);
-            for (int i=0; i<nrNeg; i++) negLevelOfFB[i] = genomeHandler->readDouble(0,256);
+            for (int i=0; i<nrPos; i++) posLevelOfFB[i] = genomeHandler->readDouble(0,256, AbstractGate::DATA_CODE, gateID);
+            for (int i=0; i<nrNeg; i++) negLevelOfFB[i] = genomeHandler->readDouble(0,256, AbstractGate::DATA_CODE, gateID);
 			if (genomeHandler->atEOC()) {
 				shared_ptr<FeedbackGate> nullObj = nullptr;
 				return nullObj;
@@ -579,14 +574,14 @@ void Gate_Builder::setupGates() {
                     rawTable[rowi][outputi] = int(255*p);
                 }
             }
-            posFBNode = genomeHandler->readInt(0,255); // we will scale to, say, 256 and floor later.
-            negFBNode = genomeHandler->readInt(0,255);
-            nrPos = genomeHandler->readInt(0,3);
-            nrNeg = genomeHandler->readInt(0,3);
+            posFBNode = genomeHandler->readInt(0,255, AbstractGate::IN_ADDRESS_CODE, gateID); // we will scale to, say, 256 and floor later.
+            negFBNode = genomeHandler->readInt(0,255, AbstractGate::IN_ADDRESS_CODE, gateID);
+            nrPos = genomeHandler->readInt(0,3, AbstractGate::DATA_CODE, gateID);
+            nrNeg = genomeHandler->readInt(0,3, AbstractGate::DATA_CODE, gateID);
             posLevelOfFB.resize(nrPos);
             negLevelOfFB.resize(nrNeg);
-            for (int i=0; i<nrPos; i++) posLevelOfFB[i] = genomeHandler->readDouble(0,256);
-            for (int i=0; i<nrNeg; i++) negLevelOfFB[i] = genomeHandler->readDouble(0,256);
+            for (int i=0; i<nrPos; i++) posLevelOfFB[i] = genomeHandler->readDouble(0,256, AbstractGate::DATA_CODE, gateID);
+            for (int i=0; i<nrNeg; i++) negLevelOfFB[i] = genomeHandler->readDouble(0,256, AbstractGate::DATA_CODE, gateID);
 			if (genomeHandler->atEOC()) {
 				shared_ptr<DecomposableFeedbackGate> nullObj = nullptr;
 				return nullObj;
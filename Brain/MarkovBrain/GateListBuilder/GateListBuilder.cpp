@@ -9,9 +9,12 @@
 //         github.com/Hintzelab/MABE/wiki/License
 
 
+#include <algorithm>
+#include <map>
+
 #include "GateListBuilder.h"
 
-vector<shared_ptr<AbstractGate>> ClassicGateListBuilder::buildGateListAndGetAllValues(shared_ptr<AbstractGenome> genome, int nrOfBrainStates, int maxValue, vector<int> &genomeHeadValues, int genomeHeadValuesCount, vector<vector<int>> &genomePerGateValues, int genomePerGateValuesCount, shared_ptr<ParametersTable> gatePT) {
+vector<shared_ptr<AbstractGate>> ClassicGateListBuilder::buildGateListAndGetAllValues(shared_ptr<AbstractGenome> genome, int nrOfBrainStates, int maxValue, vector<int> &genomeHeadValues, int genomeHeadValuesCount, vector<vector<int>> &genomePerGateValues, int genomePerGateValuesCount, shared_ptr<ParametersTable> gatePT, vector<GeneRecord>* genes) {
 
 	vector<shared_ptr<AbstractGate>> gates;
 	int codonMax = (1 << Gate_Builder::bitsPerCodonPL->get(PT)) - 1;
@@ -56,7 +59,9 @@ vector<shared_ptr<AbstractGate>> ClassicGateListBuilder::buildGateListAndGetAllV
 					gateGenomeHandler->toggleReadDirection();  // reverse the read direction again
 					gateGenomeHandler->readInt(0, codonMax, AbstractGate::START_CODE, gateCount);  // mark start codon in genomes coding region
 					gateGenomeHandler->readInt(0, codonMax, AbstractGate::START_CODE, gateCount);
+					int geneStart = gateGenomeHandler->getIndex() - 2;
 					shared_ptr<AbstractGate> newGate = gateBuilder.makeGate[testSite1Value](gateGenomeHandler, gateCount, gatePT);
+					int gateIndex = -1;
 
 					if (newGate != nullptr) {
 						// now read perGate values from genome
@@ -67,10 +72,14 @@ vector<shared_ptr<AbstractGate>> ClassicGateListBuilder::buildGateListAndGetAllV
 							i++;
 						}
 						if (!gateGenomeHandler->atEOC()) {  // we may run out of space while reading the perGate sites...
+							gateIndex = (int)gates.size();
 							gates.push_back(newGate);
 							genomePerGateValues.push_back(thisGatesValues);
 						}
 					}
+					if (genes != nullptr && geneStart >= 0) {
+						genes->push_back({ geneStart, gateGenomeHandler->atEOC() ? -1 : gateGenomeHandler->getIndex() - geneStart, gateIndex });
+					}
 					gateCount++;
 			}
 			if (mustReadAll) {  // if start codon values are bigger then the alphabetSize of the genome, we must step forward one genome site at a time (slow)
@@ -90,3 +99,118 @@ vector<shared_ptr<AbstractGate>> ClassicGateListBuilder::buildGateListAndGetAllV
 	return gates;
 }
 
+// genes are only decoded where the offspring genome may differ from the parent genome, i.e. where the gene's sites were
+// point mutated or are not contiguous in the offspring, plus at each place where a new start codon may have appeared.
+// all other genes are shifted to their new location and their gates copied. In order to build exactly the gate list
+// buildGateList() would, genes are visited in genome order with the same gateCount and the same (one) gateGenomeHandler
+// (once a gene runs past the end of the genome, gates from all later genes are discarded).
+bool ClassicGateListBuilder::rebuildGateList(shared_ptr<AbstractGenome> genome, const vector<GeneRecord>& parentGenes, const vector<shared_ptr<AbstractGate>>& parentGates,
+                                             vector<shared_ptr<AbstractGate>>& gates, vector<bool>& newGates, vector<GeneRecord>& genes, shared_ptr<ParametersTable> gatePT) {
+	int codonMax = (1 << Gate_Builder::bitsPerCodonPL->get(PT)) - 1;
+	if (!genome->mutationLogValid || codonMax > genome->getAlphabetSize()) {  // start codons span more then one site, don't try to be clever
+		return false;
+	}
+	auto testHandler = genome->newHandler(genome, true);
+	auto gateGenomeHandler = genome->newHandler(genome, true);
+	if (testHandler->getIndex() < 0) {  // this genome can not tell us where genes are
+		return false;
+	}
+
+	int childSize = genome->countSites();
+	int parentSize = childSize;
+	for (auto const& edit : genome->structuralLog) {
+		parentSize += (edit.insertAt >= 0) ? -edit.length : edit.length;
+	}
+	if (childSize < 3 || parentSize < 3 || (!parentGenes.empty() && parentGenes.back().start > parentSize - 3)) {
+		return false;
+	}
+
+	// replay copy and delete mutations to find where each parent site ended up
+	auto segments = AbstractGenome::replayStructuralEdits(parentSize, genome->structuralLog);
+
+	vector<int> mutatedSites = genome->mutationLog;  // parent sites
+	sort(mutatedSites.begin(), mutatedSites.end());
+	mutatedSites.erase(unique(mutatedSites.begin(), mutatedSites.end()), mutatedSites.end());
+
+	// offspring site -> index of the parent gene which can be copied to that site, or -1 if the site must be checked for a start codon
+	map<int, int> candidates;
+	for (auto const& seg : segments) {
+		int parentEnd = seg.parentStart + seg.length;
+		auto gene = lower_bound(parentGenes.begin(), parentGenes.end(), seg.parentStart, [](const GeneRecord& g, int site) {return g.start < site;});
+		for (; gene != parentGenes.end() && gene->start < parentEnd; gene++) {
+			int childSite = seg.childStart + (gene->start - seg.parentStart);
+			auto mutation = lower_bound(mutatedSites.begin(), mutatedSites.end(), gene->start);
+			if (gene->length >= 0 && gene->start + gene->length <= parentEnd && childSite + gene->length < childSize
+					&& (mutation == mutatedSites.end() || *mutation >= gene->start + gene->length)) {
+				candidates.emplace(childSite, (int)(gene - parentGenes.begin()));
+			} else {
+				candidates[childSite] = -1;
+			}
+		}
+		// a point mutation may make a start codon with either neighbor
+		auto mutation = lower_bound(mutatedSites.begin(), mutatedSites.end(), seg.parentStart);
+		for (; mutation != mutatedSites.end() && *mutation < parentEnd; mutation++) {
+			int childSite = seg.childStart + (*mutation - seg.parentStart);
+			candidates[childSite] = -1;
+			if (childSite > 0) {
+				candidates[childSite - 1] = -1;
+			}
+		}
+		// as may the sites on either side of a join
+		if (seg.childStart > 0) {
+			candidates[seg.childStart - 1] = -1;
+		}
+		// the last two sites of the parent were never checked
+		if (seg.parentStart <= parentSize - 2 && parentSize - 2 < parentEnd) {
+			candidates[seg.childStart + (parentSize - 2 - seg.parentStart)] = -1;
+		}
+	}
+
+	int gateCount = 0;
+	int testSite1Value, testSite2Value;
+	for (auto const& candidate : candidates) {
+		int site = candidate.first;
+		if (site > childSize - 3) {  // buildGateList() stops here
+			break;
+		}
+		if (candidate.second >= 0) {  // unchanged gene, copy it's gate
+			auto const& parentGene = parentGenes[candidate.second];
+			int gateIndex = -1;
+			if (parentGene.gateIndex >= 0 && !gateGenomeHandler->atEOC()) {
+				auto newGate = parentGates[parentGene.gateIndex]->makeCopy();
+				newGate->ID = gateCount;
+				newGate->resetGate();  // don't inherit the parent's run time state
+				gateIndex = (int)gates.size();
+				gates.push_back(newGate);
+				newGates.push_back(false);
+			}
+			genes.push_back({ site, gateGenomeHandler->atEOC() ? -1 : parentGene.length, gateIndex });
+			gateCount++;
+			continue;
+		}
+		testHandler->resetHandler();
+		testHandler->advanceIndex(site);
+		testSite1Value = testHandler->readInt(0, codonMax);
+		testSite2Value = testHandler->readInt(0, codonMax);
+		if (gateBuilder.gateStartCodes[testSite1Value].size() != 0 && gateBuilder.gateStartCodes[testSite1Value][1] == testSite2Value) {  // if we found a start codon
+			// decode as buildGateListAndGetAllValues() does
+			testHandler->copyTo(gateGenomeHandler);
+			gateGenomeHandler->toggleReadDirection();
+			gateGenomeHandler->readInt(0, codonMax);  // move back 2 start codon values
+			gateGenomeHandler->readInt(0, codonMax);
+			gateGenomeHandler->toggleReadDirection();  // reverse the read direction again
+			gateGenomeHandler->readInt(0, codonMax, AbstractGate::START_CODE, gateCount);  // mark start codon in genomes coding region
+			gateGenomeHandler->readInt(0, codonMax, AbstractGate::START_CODE, gateCount);
+			shared_ptr<AbstractGate> newGate = gateBuilder.makeGate[testSite1Value](gateGenomeHandler, gateCount, gatePT);
+			int gateIndex = -1;
+			if (newGate != nullptr && !gateGenomeHandler->atEOC()) {
+				gateIndex = (int)gates.size();
+				gates.push_back(newGate);
+				newGates.push_back(true);
+			}
+			genes.push_back({ site, gateGenomeHandler->atEOC() ? -1 : gateGenomeHandler->getIndex() - site, gateIndex });
+			gateCount++;
+		}
+	}
+	return true;
+}
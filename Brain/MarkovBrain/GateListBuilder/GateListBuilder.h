@@ -29,6 +29,13 @@ class AbstractGateListBuilder {
 	const shared_ptr<ParametersTable> PT;
 	Gate_Builder gateBuilder;
 
+	// where a gene (start codon and the sites read by makeGate) was found in a genome
+	struct GeneRecord {
+		int start;  // site index of the first site of the start codon
+		int length;  // number of sites read, or -1 if the read passed the end of the genome
+		int gateIndex;  // index of the gate built from this gene in the gate list, or -1 if no gate was kept
+	};
+
 
 	AbstractGateListBuilder(shared_ptr<ParametersTable> _PT = nullptr) : PT(_PT), gateBuilder(PT) {
 	}
@@ -45,10 +52,11 @@ class AbstractGateListBuilder {
 	virtual set<string> getInUseGateNames(){
 		return gateBuilder.inUseGateNames;
 	}
-	virtual vector<shared_ptr<AbstractGate>> buildGateList(shared_ptr<AbstractGenome> genome, int nrOfBrainStates, shared_ptr<ParametersTable> gatePT){
+	// if genes is provided, a GeneRecord is added for every start codon found (see rebuildGateList())
+	virtual vector<shared_ptr<AbstractGate>> buildGateList(shared_ptr<AbstractGenome> genome, int nrOfBrainStates, shared_ptr<ParametersTable> gatePT, vector<GeneRecord>* genes = nullptr){
 		vector<int> temp1;
 		vector<vector<int>> temp2;
-		return buildGateListAndGetAllValues(genome, nrOfBrainStates, 0, temp1, 0, temp2, 0, gatePT);
+		return buildGateListAndGetAllValues(genome, nrOfBrainStates, 0, temp1, 0, temp2, 0, gatePT, genes);
 	}
 
 	virtual vector<shared_ptr<AbstractGate>> buildGateListAndGetHeadValues(shared_ptr<AbstractGenome> genome, int nrOfBrainStates, int maxValue, vector<int> &genomeHeadValues, int genomeHeadValuesCount, shared_ptr<ParametersTable> gatePT){
@@ -63,7 +71,16 @@ class AbstractGateListBuilder {
 
 	virtual vector<shared_ptr<AbstractGate>> buildGateListAndGetAllValues(shared_ptr<AbstractGenome> genome, int nrOfBrainStates,
             int maxValue, vector<int> &genomeHeadValues, int genomeHeadValuesCount,
-            vector<vector<int>> &genomePerGateValues, int genomePerGateValuesCount, shared_ptr<ParametersTable> gatePT) = 0;
+            vector<vector<int>> &genomePerGateValues, int genomePerGateValuesCount, shared_ptr<ParametersTable> gatePT, vector<GeneRecord>* genes = nullptr) = 0;
+
+	// build the gate list for genome (which was made from a parent genome by the mutations in it's logs) by
+	// copying the parent's gates where the genes that made them were not changed and decoding only the rest.
+	// parentGenes and parentGates are from the parent's buildGateList(). newGates[i] is set true if gates[i] was
+	// decoded (and so still needs applyNodeMap()). the undefined action is to return false (i.e. use buildGateList())
+	virtual bool rebuildGateList(shared_ptr<AbstractGenome> genome, const vector<GeneRecord>& parentGenes, const vector<shared_ptr<AbstractGate>>& parentGates,
+	                             vector<shared_ptr<AbstractGate>>& gates, vector<bool>& newGates, vector<GeneRecord>& genes, shared_ptr<ParametersTable> gatePT) {
+		return false;
+	}
 
 };
 
@@ -80,6 +97,9 @@ class ClassicGateListBuilder : public AbstractGateListBuilder {
 
 	virtual vector<shared_ptr<AbstractGate>> buildGateListAndGetAllValues(shared_ptr<AbstractGenome> genome, int nrOfBrainStates,
 	                                               int maxValue, vector<int> &genomeHeadValues, int genomeHeadValuesCount,
-	                                               vector<vector<int>> &genomePerGateValues, int genomePerGateValuesCount, shared_ptr<ParametersTable> gatePT);
+	                                               vector<vector<int>> &genomePerGateValues, int genomePerGateValuesCount, shared_ptr<ParametersTable> gatePT, vector<GeneRecord>* genes = nullptr) override;
+
+	virtual bool rebuildGateList(shared_ptr<AbstractGenome> genome, const vector<GeneRecord>& parentGenes, const vector<shared_ptr<AbstractGate>>& parentGates,
+	                             vector<shared_ptr<AbstractGate>>& gates, vector<bool>& newGates, vector<GeneRecord>& genes, shared_ptr<ParametersTable> gatePT) override;
 };
 
@@ -72,7 +72,8 @@ MarkovBrain::MarkovBrain(shared_ptr<AbstractGateListBuilder> _GLB, int _nrInNode
 MarkovBrain::MarkovBrain(shared_ptr<AbstractGateListBuilder> _GLB, unordered_map<string, shared_ptr<AbstractGenome>>& _genomes, int _nrInNodes, int _nrOutNodes, shared_ptr<ParametersTable> _PT) :
 		MarkovBrain(_GLB, _nrInNodes, _nrOutNodes, _PT) {
 	//cout << "in MarkovBrain::MarkovBrain(shared_ptr<Base_GateListBuilder> _GLB, shared_ptr<AbstractGenome> genome, int _nrOfBrainStates)\n\tabout to - gates = GLB->buildGateList(genome, nrOfBrainStates);" << endl;
-	gates = GLB->buildGateList(_genomes[genomeName], nrNodes, _PT);
+	genes = make_shared<vector<AbstractGateListBuilder::GeneRecord>>();
+	gates = GLB->buildGateList(_genomes[genomeName], nrNodes, _PT, genes.get());
 	inOutReMap();  // map ins and outs from genome values to brain states
 	fillInConnectionsLists();
 }
@@ -84,6 +85,28 @@ shared_ptr<AbstractBrain> MarkovBrain::makeBrain(unordered_map<string, shared_pt
 	return newBrain;
 }
 
+shared_ptr<AbstractBrain> MarkovBrain::makeBrainFrom(shared_ptr<AbstractBrain> parent, unordered_map<string, shared_ptr<AbstractGenome>>& _genomes) {
+	auto castParent = dynamic_pointer_cast<MarkovBrain>(parent);
+	if (reuseOnSilentMutationsPL->get(PT) && castParent != nullptr && castParent->genes != nullptr) {
+		vector<shared_ptr<AbstractGate>> newGates;
+		vector<bool> decoded;
+		auto newGenes = make_shared<vector<AbstractGateListBuilder::GeneRecord>>();
+		if (GLB->rebuildGateList(_genomes[genomeName], *castParent->genes, castParent->gates, newGates, decoded, *newGenes, PT)) {
+			shared_ptr<MarkovBrain> newBrain = make_shared<MarkovBrain>(GLB, nrInputValues, nrOutputValues, PT);
+			newBrain->gates = newGates;
+			for (size_t i = 0; i < newGates.size(); i++) {
+				if (decoded[i]) {  // copied gates are already mapped
+					newGates[i]->applyNodeMap(newBrain->nodeMap, newBrain->nrNodes);
+				}
+			}
+			newBrain->genes = newGenes;
+			newBrain->fillInConnectionsLists();
+			return newBrain;
+		}
+	}
+	return makeBrain(_genomes);
+}
+
 void MarkovBrain::resetBrain() {
 	AbstractBrain::resetBrain();
 	nodes.assign(nrNodes, 0.0);
@@ -104,6 +127,31 @@ void MarkovBrain::resetOutputs() {
 	}
 }
 
+// only brains built entirely from table gates (and not randomizing unconnected outputs) are deterministic
+bool MarkovBrain::isDeterministic() {
+	if (randomizeUnconnectedOutputs) {
+		return false;
+	}
+	for (auto const& g : gates) {
+		if (g->gateType() != "Deterministic" && g->gateType() != "TritDeterministic") {
+			return false;
+		}
+	}
+	return true;
+}
+
+// input nodes are overwritten at the start of each update, so only output and hidden nodes are state
+void MarkovBrain::getInternalState(vector<double>& state) {
+	state.insert(state.end(), nodes.begin() + nrInputValues, nodes.end());
+}
+
+void MarkovBrain::setInternalState(const vector<double>& state) {
+	copy(state.begin(), state.begin() + (nrNodes - nrInputValues), nodes.begin() + nrInputValues);
+	for (int i = 0; i < nrOutputValues; i++){
+		outputValues[i] = nodes[nrInputValues+i];
+	}
+}
+
 void MarkovBrain::update() {
 	nextNodes.assign(nrNodes, 0.0);
 	for (int i = 0; i < nrInputValues; i++){
@@ -164,34 +212,57 @@ void MarkovBrain::fillInConnectionsLists() {
 		}
 	}
 }
+// the keys MarkovBrain stats are saved with for one prefix and set of gate types (see addStatsTo())
+struct MarkovBrainStatKeys {
+	DataMap::Key gates;
+	vector<string> gateTypes;  // in use gate types, in the same order as gateTypeKeys
+	vector<DataMap::Key> gateTypeKeys;
+	DataMap::Key nodesConnections;
+	DataMap::Key nextNodesConnections;
+	string nodesConnectionsBehavior;
+	string nextNodesConnectionsBehavior;
+};
+
 DataMap MarkovBrain::getStats(string& prefix) {
 	DataMap dataMap;
-	dataMap.set(prefix+"markovBrainGates",(int)gates.size());
-	map<string, int> gatecounts;
-	for (auto n : GLB->getInUseGateNames()) {
-		gatecounts[n + "Gates"] = 0;
-	}
-	for (auto g : gates) {
-		gatecounts[g->gateType() + "Gates"]++;
-	}
+	addStatsTo(dataMap, prefix);
+	return (dataMap);
+}
 
-	for (auto n : GLB->getInUseGateNames()) {
-		dataMap.set(prefix + "markovBrain" + n + "Gates", gatecounts[n + "Gates"]);
+void MarkovBrain::addStatsTo(DataMap& dataMap, string& prefix) {
+	// stats are added for every new organism, so key names are only built the first time a prefix is used
+	static unordered_map<string, MarkovBrainStatKeys> statKeysForPrefix;
+	const set<string>& inUseGateNames = GLB->gateBuilder.inUseGateNames;
+	MarkovBrainStatKeys& keys = statKeysForPrefix[prefix];
+	if (keys.gateTypes.size() != inUseGateNames.size() || !equal(keys.gateTypes.begin(), keys.gateTypes.end(), inUseGateNames.begin())) {
+		keys.gates = DataMap::getKey(prefix + "markovBrainGates");
+		keys.gateTypes.assign(inUseGateNames.begin(), inUseGateNames.end());
+		keys.gateTypeKeys.clear();
+		for (auto const& n : keys.gateTypes) {
+			keys.gateTypeKeys.push_back(DataMap::getKey(prefix + "markovBrain" + n + "Gates"));
+		}
+		keys.nodesConnections = DataMap::getKey(prefix + "markovBrain_nodesConnections");
+		keys.nextNodesConnections = DataMap::getKey(prefix + "markovBrain_nextNodesConnections");
+		keys.nodesConnectionsBehavior = prefix + "nodesConnections";
+		keys.nextNodesConnectionsBehavior = prefix + "nextNodesConnections";
 	}
 
-	vector<int> nodesConnectionsList;
-	vector<int> nextNodesConnectionsList;
-
-	for (int i = 0; i < nrNodes; i++) {
-		nodesConnectionsList.push_back(nodesConnections[i]);
-		nextNodesConnectionsList.push_back(nextNodesConnections[i]);
+	dataMap.set(keys.gates, (int)gates.size());
+	vector<int> gateCounts(keys.gateTypes.size(), 0);
+	for (auto const& g : gates) {
+		auto found = find(keys.gateTypes.begin(), keys.gateTypes.end(), g->gateType());
+		if (found != keys.gateTypes.end()) {
+			gateCounts[found - keys.gateTypes.begin()]++;
+		}
+	}
+	for (size_t i = 0; i < gateCounts.size(); i++) {
+		dataMap.set(keys.gateTypeKeys[i], gateCounts[i]);
 	}
-	dataMap.set(prefix+"markovBrain_nodesConnections", nodesConnectionsList);
-	dataMap.setOutputBehavior(prefix+"nodesConnections", DataMap::LIST);
-	dataMap.set(prefix+"markovBrain_nextNodesConnections", nextNodesConnectionsList);
-	dataMap.setOutputBehavior(prefix+"nextNodesConnections", DataMap::LIST);
 
-	return (dataMap);
+	dataMap.set(keys.nodesConnections, vector<int>(nodesConnections.begin(), nodesConnections.begin() + nrNodes));
+	dataMap.setOutputBehavior(keys.nodesConnectionsBehavior, DataMap::LIST);
+	dataMap.set(keys.nextNodesConnections, vector<int>(nextNodesConnections.begin(), nextNodesConnections.begin() + nrNodes));
+	dataMap.setOutputBehavior(keys.nextNodesConnectionsBehavior, DataMap::LIST);
 }
 
 string MarkovBrain::gateList() {
@@ -262,5 +333,6 @@ shared_ptr<AbstractBrain> MarkovBrain::makeCopy(shared_ptr<ParametersTable> _PT)
 		_gates.push_back(gate->makeCopy());
 	}
 	auto newBrain = make_shared<MarkovBrain>(_gates, nrInputValues, nrOutputValues, _PT);
+	newBrain->genes = genes;
 	return newBrain;
 }
@@ -61,6 +61,9 @@ class MarkovBrain : public AbstractBrain {
 	//static void initializeParameters();
 	vector<int> nodeMap;
 
+	// where each gate was found in the genome this brain was built from (shared with copies), used to rebuild offspring incrementally
+	shared_ptr<vector<AbstractGateListBuilder::GeneRecord>> genes;
+
 	/*
 	 * Builds a look up table to convert genome site values into brain state addresses - this is only used when there is a fixed number of brain states
 	 * if there is a variable number of brain states, then the node map must be rebuilt.
@@ -91,10 +94,13 @@ class MarkovBrain : public AbstractBrain {
 
 	// Make a brain like the brain that called this function, using genomes and initalizing other elements.
 	virtual shared_ptr<AbstractBrain> makeBrain(unordered_map<string, shared_ptr<AbstractGenome>>& _genomes) override;
+	// only decode the parts of the offspring genome which mutations changed, copying the parent's gates for the rest
+	virtual shared_ptr<AbstractBrain> makeBrainFrom(shared_ptr<AbstractBrain> parent, unordered_map<string, shared_ptr<AbstractGenome>>& _genomes) override;
 
 	virtual string description() override;
 	void fillInConnectionsLists();
 	virtual DataMap getStats(string& prefix) override;
+	virtual void addStatsTo(DataMap& dataMap, string& prefix) override;
 	virtual string getType() override {
 		return "Markov";
 	}
@@ -103,6 +109,13 @@ class MarkovBrain : public AbstractBrain {
 	virtual void resetOutputs()override;
 	virtual void resetInputs() override;
 
+	virtual bool isDeterministic() override;
+	virtual void getInternalState(vector<double>& state) override;
+	virtual void setInternalState(const vector<double>& state) override;
+	virtual bool isGenomeEncoded() override {
+		return true;
+	}
+
 	virtual string gateList();
 	virtual vector<vector<int>> getConnectivityMatrix();
 	virtual int brainSize();
@@ -15,7 +15,58 @@
 shared_ptr<ParameterLink<string>> AbstractGenome::genomeTypeStrPL = Parameters::register_parameter("GENOME-genomeType", (string) "This_string_is_set_by_modules.h", "This_string_is_set_by_modules.h");  // string parameter for outputMethod;
 ////// GENOME-genomeType is actually set by Modules.h //////
 shared_ptr<ParameterLink<double>> AbstractGenome::alphabetSizePL = Parameters::register_parameter("GENOME-alphabetSize", 256.0, "alphabet size for genome");  // string parameter for outputMethod;
-shared_ptr<ParameterLink<string>> AbstractGenome::genomeSitesTypePL = Parameters::register_parameter("GENOME-sitesType", (string) "char", "type for sites in genome [char, int, double, bool]");  // string parameter for outputMethod;
+shared_ptr<ParameterLink<string>> AbstractGenome::genomeSitesTypePL = Parameters::register_parameter("GENOME-sitesType", (string) "char", "type for sites in genome [char, int, double, bool, packed]. packed (Circular genome only) stores char sites with 1, 2 or 4 bits per site and requires alphabetSize <= 16");  // string parameter for outputMethod;
+shared_ptr<ParameterLink<bool>> AbstractGenome::shareIdenticalPL = Parameters::register_parameter("GENOME-shareIdentical", false, "if true, a new genome which is identical to an existing genome shares it's sites (Circular genome only) and the number of unique genomes (uniqueGenomes and totalGenomes) is written to the pop file");
 
+// make sure that a segment starts at childSite (splitting the segment containing childSite if needed)
+// returns the index of that segment (segments.size() if childSite is the end of the genome)
+static int splitSegments(vector<AbstractGenome::GenomeSegment>& segments, int childSite) {
+	for (int i = 0; i < (int)segments.size(); i++) {
+		auto& seg = segments[i];
+		if (seg.childStart == childSite) {
+			return i;
+		}
+		if (childSite < seg.childStart + seg.length) {
+			int offset = childSite - seg.childStart;
+			AbstractGenome::GenomeSegment tail = { childSite, seg.parentStart + offset, seg.length - offset };
+			seg.length = offset;
+			segments.insert(segments.begin() + i + 1, tail);
+			return i + 1;
+		}
+	}
+	return (int)segments.size();
+}
 
+// recompute childStart after segments were added or removed and merge segments which are still contiguous in the parent
+static void settleSegments(vector<AbstractGenome::GenomeSegment>& segments) {
+	vector<AbstractGenome::GenomeSegment> settled;
+	int childSite = 0;
+	for (auto seg : segments) {
+		if (!settled.empty() && settled.back().parentStart + settled.back().length == seg.parentStart) {
+			settled.back().length += seg.length;
+		} else {
+			seg.childStart = childSite;
+			settled.push_back(seg);
+		}
+		childSite += seg.length;
+	}
+	segments = settled;
+}
 
+// replay copy and delete mutations (in order) on a genome with parentSize sites to find where each parent site ended up
+vector<AbstractGenome::GenomeSegment> AbstractGenome::replayStructuralEdits(int parentSize, const vector<StructuralEdit>& edits) {
+	vector<GenomeSegment> segments = { { 0, 0, parentSize } };
+	for (auto const& edit : edits) {
+		int first = splitSegments(segments, edit.position);
+		int last = splitSegments(segments, edit.position + edit.length);
+		if (edit.insertAt >= 0) {
+			vector<GenomeSegment> copied(segments.begin() + first, segments.begin() + last);
+			int insertIndex = splitSegments(segments, edit.insertAt);
+			segments.insert(segments.begin() + insertIndex, copied.begin(), copied.end());
+		} else {
+			segments.erase(segments.begin() + first, segments.begin() + last);
+		}
+		settleSegments(segments);
+	}
+	return segments;
+}
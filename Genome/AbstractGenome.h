@@ -31,6 +31,7 @@ public:
 	static shared_ptr<ParameterLink<string>> genomeTypeStrPL;
 	static shared_ptr<ParameterLink<double>> alphabetSizePL;
 	static shared_ptr<ParameterLink<string>> genomeSitesTypePL;
+	static shared_ptr<ParameterLink<bool>> shareIdenticalPL;
 
 	const shared_ptr<ParametersTable> PT;
 
@@ -84,6 +85,21 @@ public:
 		//// no undefined action, this function must be defined
 		virtual int readInt(int valueMin, int valueMax, int code = -1, int CodingRegionIndex = 0) = 0;
 
+		// read count values in range [min,max] into values, the same as count calls to readInt()
+		// genomes may override this to read many values without a call per value
+		virtual void readInts(int* values, int count, int valueMin, int valueMax, int code = -1, int CodingRegionIndex = 0) {
+			for (int i = 0; i < count; i++) {
+				values[i] = readInt(valueMin, valueMax, code, CodingRegionIndex);
+			}
+		}
+
+		// advance past count values in range [min,max], the same as count calls to readInt() (without a code)
+		virtual void skipInts(int count, int valueMin, int valueMax) {
+			for (int i = 0; i < count; i++) {
+				readInt(valueMin, valueMax);
+			}
+		}
+
 		virtual double readDouble(double valueMin, double valueMax, int code = -1, int CodingRegionIndex = 0) {
 			cout << "ERROR: readDouble(double valueMin, double valueMax, int code = -1, int CodingRegionIndex = 0) in AbstractGenome::Handler was called!\n This has not been implemented yet the chromosome class you are using!\n";
 			exit(1);
@@ -120,12 +136,46 @@ public:
 		}
 
 		virtual void randomize() = 0;
+
+		// index of the next site to be read, for genomes which have a single site index (-1 otherwise)
+		virtual int getIndex() {
+			return -1;
+		}
 	};
 
 	DataMap dataMap;
 	vector<string> genomeFileColumns;  // = {"ID","alphabetSize","chromosomeCount","chromosomeLength","sitesCount","genomeAncestors","sites"};
 	vector<string> popFileColumns;  // = {"genomeLength"};
 
+	// coding region tracking - while codingSites is not empty (see clearCodingSites()), handlers mark every site
+	// they read, whatever the code of the read. reads with a code >= 0 also record the first site read with each
+	// CodingRegionIndex (i.e. where each gate, instruction or value starts)
+	vector<bool> codingSites;
+	vector<int> codingRegionStarts;  // indexed by CodingRegionIndex, -1 if no site was read with that index
+
+	// mutation tracking - lets a brain built from a parent genome be reused by an offspring where the
+	// offspring's mutations did not change what the brain reads
+	vector<int> mutationLog;  // sites changed by point mutations since this genome was made from it's parent
+
+	// a copy or delete mutation, made after all point mutations. positions are in the genome as it was when the edit was made
+	// if insertAt >= 0, sites [position,position+length) were copied and inserted before site insertAt
+	// if insertAt < 0, sites [position,position+length) were deleted
+	struct StructuralEdit {
+		int position;
+		int length;
+		int insertAt;
+	};
+	vector<StructuralEdit> structuralLog;  // in the order the edits were made
+	bool mutationLogValid = false;  // true only if mutationLog and structuralLog are the complete difference from the parent
+
+	// a run of sites in an offspring genome which were copied, in order, from a run of sites in the parent genome
+	struct GenomeSegment {
+		int childStart;
+		int parentStart;
+		int length;
+	};
+	static vector<GenomeSegment> replayStructuralEdits(int parentSize, const vector<StructuralEdit>& edits);
+
 	AbstractGenome() = delete;
 	AbstractGenome(shared_ptr<ParametersTable> _PT) : PT(_PT) {}
 
@@ -155,6 +205,12 @@ public:
 		return data;
 	}
 
+	// add the data from getStats() to dataMap (i.e. an organisms dataMap). genomes may override this
+	// to set their stats in dataMap directly rather then making a DataMap to merge
+	virtual void addStatsTo(DataMap& dataMap, string& prefix) {
+		dataMap.merge(getStats(prefix));
+	}
+
 	// convert a genome into data map with data that can be saved to file
 	virtual DataMap serialize(string& name) {
 		cout << "ERROR! In AbstractGenome::serialize(). This method has not been written for the type of genome use are using.\n  Exiting.";
@@ -163,6 +219,17 @@ public:
 		return tempDataMap;
 	}
 
+	// convert a genome into data map using format. "text" is the same as serialize(name). "binary" saves sites as
+	// length prefixed raw values and "packed" also packs each site into as few bits as the alphabet allows (see BinaryCoding.h)
+	// deserialize() must be able to read all formats
+	virtual DataMap serialize(string& name, const string& format) {
+		if (format == "text") {
+			return serialize(name);
+		}
+		cout << "ERROR! In AbstractGenome::serialize(). format \"" << format << "\" has not been written for the type of genome use are using.\n  Exiting." << endl;
+		exit(1);
+	}
+
 	// given a an unordered_map<string, string> and PT, load data into this genome
 	virtual void deserialize (shared_ptr<ParametersTable> PT, unordered_map<string, string>& orgData, string& name) {
 		cout << "ERROR! In AbstractGenome::deserialize(). This method has not been written for the type of genome use are using.\n  Exiting.";
@@ -216,5 +283,20 @@ public:
 
 	virtual void recordDataMap() = 0;
 
+	// start marking coding sites. the undefined action is to leave codingSites empty (i.e. not supported)
+	virtual void clearCodingSites() {
+	}
+
+	// hash of the genome's content; genomes with the same content must have the same hash
+	// the undefined action is to return 0 (see sameContent())
+	virtual size_t contentHash() {
+		return 0;
+	}
+
+	// true if other has exactly the same content as this genome. the undefined action is to return false (i.e. never the same)
+	virtual bool sameContent(shared_ptr<AbstractGenome> other) {
+		return false;
+	}
+
 };
 
@@ -0,0 +1,398 @@
+//  MABE is a product of The Hintze Lab @ MSU
+//     for general research information:
+//         hintzelab.msu.edu
+//     for MABE documentation:
+//         github.com/Hintzelab/MABE/wiki
+//
+//  Copyright (c) 2015 Michigan State University. All rights reserved.
+//     to view the full license, visit:
+//         github.com/Hintzelab/MABE/wiki/License
+
+#pragma once
+
+#include <algorithm>
+#include <functional>
+#include <iostream>
+#include <memory>
+#include <type_traits>
+#include <vector>
+
+using namespace std;
+
+// storage for genome sites as a list of fixed size blocks (chunks). Copying a ChunkedSites only copies the list,
+// the chunks are shared until one of the copies writes to them (i.e. copy on write), so a parent and its offspring
+// only hold separate copies of the chunks which were changed by mutations.
+// all chunks but the last hold exactly chunkSize() sites, so reading a site is a shift and a mask.
+// when a chunk is no longer used (e.g. when an organism is killed) it's buffer is kept in a pool and reused
+// for the next new chunk, so that steady state runs do not need to allocate memory for sites.
+// integer sites can also be packed (see setSiteBits()), in which case each element of a chunk holds several sites.
+// a hash of the sites (see contentHash()) is kept up to date as single sites are set or added, so that genomes can be
+// compared (and shared, see CircularGenome::shareIdentical()) without reading all of their sites.
+template<class T>
+class ChunkedSites {
+	vector<shared_ptr<vector<T>>> chunks;
+	int count = 0;
+	int chunkShift = 30;  // chunk size is 1 << chunkShift
+	int chunkMask = (1 << 30) - 1;
+	int bitsPerSite = 0;  // 0 = not packed, one site per element
+	int elementShift = 0;  // if packed, each element holds 1 << elementShift sites
+	int elementMask = 0;
+	size_t sitesHash = 0;  // sum of siteHash() for each site, if hashKnown
+	bool hashKnown = true;
+
+	struct BufferPool {
+		vector<vector<T>*> buffers;
+		size_t sites = 0;  // total capacity of buffers
+		size_t sitesLimit = 0;
+	};
+
+	// never deleted, so that chunks released during static destruction can still be returned
+	static BufferPool& bufferPool() {
+		static thread_local BufferPool* pool = new BufferPool();
+		return *pool;
+	}
+
+	static void recycleBuffer(vector<T>* buffer) {
+		auto& pool = bufferPool();
+		if (pool.sites + buffer->capacity() <= pool.sitesLimit) {
+			pool.sites += buffer->capacity();
+			buffer->clear();
+			pool.buffers.push_back(buffer);
+		} else {
+			delete buffer;
+		}
+	}
+
+	// an empty chunk, using a pooled buffer if there is one
+	static shared_ptr<vector<T>> newChunk() {
+		auto& pool = bufferPool();
+		vector<T>* buffer;
+		if (pool.buffers.empty()) {
+			buffer = new vector<T>();
+		} else {
+			buffer = pool.buffers.back();
+			pool.buffers.pop_back();
+			pool.sites -= buffer->capacity();
+		}
+		return shared_ptr<vector<T>>(buffer, recycleBuffer);
+	}
+
+	// hash of value at index. the hash of the sites is the sum of these, so it can be updated one site at a time
+	static size_t siteHash(int index, T value) {
+		unsigned long long h = (unsigned long long)hash<T>()(value) * 0x9e3779b97f4a7c15ull + (unsigned long long)index;
+		h = (h ^ (h >> 30)) * 0xbf58476d1ce4e5b9ull;
+		h = (h ^ (h >> 27)) * 0x94d049bb133111ebull;
+		return (size_t)(h ^ (h >> 31));
+	}
+
+	// get a chunk which is not shared with any other ChunkedSites (so that it can be written to)
+	vector<T>& writableChunk(int chunkIndex) {
+		if (chunks[chunkIndex].use_count() > 1) {
+			auto chunk = newChunk();
+			chunk->assign(chunks[chunkIndex]->begin(), chunks[chunkIndex]->end());
+			chunks[chunkIndex] = chunk;
+		}
+		return *chunks[chunkIndex];
+	}
+
+	// number of sites in chunk chunkIndex
+	int sitesInChunk(int chunkIndex) const {
+		return (chunkIndex < (int)chunks.size() - 1) ? chunkSize() : count - (chunkIndex << chunkShift);
+	}
+
+	// bit operations for packed sites. these only exist for integer sites (setSiteBits() will not allow packing otherwise)
+	typedef integral_constant<bool, is_integral<T>::value && !is_same<T, bool>::value> packable;
+
+	static T unpack(T element, int offset, int bits, true_type) {
+		return (T)(((unsigned long long)element >> offset) & ((1ull << bits) - 1));
+	}
+
+	static T unpack(T element, int offset, int bits, false_type) {
+		return T();
+	}
+
+	static void pack(T& element, int offset, int bits, T value, true_type) {
+		unsigned long long mask = ((1ull << bits) - 1) << offset;
+		element = (T)(((unsigned long long)element & ~mask) | (((unsigned long long)value << offset) & mask));
+	}
+
+	template<class Element>
+	static void pack(Element&& element, int offset, int bits, T value, false_type) {
+	}
+
+	// site local of a packed chunk
+	T getPacked(const vector<T>& chunk, int local) const {
+		return unpack(chunk[local >> elementShift], (local & elementMask) * bitsPerSite, bitsPerSite, packable());
+	}
+
+	// add a site to the end of a packed chunk which holds local sites
+	void pushPacked(vector<T>& chunk, int local, T value) {
+		if ((local & elementMask) == 0) {
+			chunk.push_back(T());
+		}
+		pack(chunk.back(), (local & elementMask) * bitsPerSite, bitsPerSite, value, packable());
+	}
+
+	// add sites [offset, offset + length) of a packed chunk to the end of a packed chunk which holds local sites
+	// if the sites line up, whole elements are copied
+	void appendPacked(vector<T>& chunk, int local, const vector<T>& fromChunk, int offset, int length) {
+		int i = 0;
+		if ((local & elementMask) == (offset & elementMask)) {
+			while (i < length && ((local + i) & elementMask) != 0) {
+				pushPacked(chunk, local + i, getPacked(fromChunk, offset + i));
+				i++;
+			}
+			while (length - i > elementMask) {
+				chunk.push_back(fromChunk[(offset + i) >> elementShift]);
+				i += elementMask + 1;
+			}
+		}
+		for (; i < length; i++) {
+			pushPacked(chunk, local + i, getPacked(fromChunk, offset + i));
+		}
+	}
+
+public:
+	// maximum number of sites (total buffer capacity) kept for reuse. 0 turns off pooling
+	static void setPoolLimit(size_t sitesLimit) {
+		bufferPool().sitesLimit = sitesLimit;
+	}
+
+	ChunkedSites(int _chunkSize = 0) {
+		setChunkSize(_chunkSize);
+	}
+
+	// chunkSize must be a power of 2. if chunkSize is 0, all sites are kept in one chunk
+	void setChunkSize(int _chunkSize) {
+		if (_chunkSize < 0 || (_chunkSize & (_chunkSize - 1)) != 0) {
+			cout << "ERROR: in ChunkedSites::setChunkSize(), chunk size must be 0 or a power of 2. current value: " << _chunkSize << endl;
+			exit(1);
+		}
+		if (count > 0) {
+			cout << "ERROR: in ChunkedSites::setChunkSize(), chunk size can only be set while there are no sites!" << endl;
+			exit(1);
+		}
+		chunkShift = 30;
+		if (_chunkSize > 0) {
+			chunkShift = 0;
+			while ((1 << chunkShift) < _chunkSize) {
+				chunkShift++;
+			}
+		}
+		chunkMask = (1 << chunkShift) - 1;
+	}
+
+	// store each site in bits bits (1, 2 or 4 ...) so that several sites share one element. bits = 0 turns off packing
+	// sites must be integers in [0, 2^bits)
+	void setSiteBits(int bits) {
+		int elementBits = (int)sizeof(T) * 8;
+		if (bits != 0 && (!packable::value || (bits & (bits - 1)) != 0 || bits >= elementBits)) {
+			cout << "ERROR: in ChunkedSites::setSiteBits(), can not pack sites of this type with " << bits << " bits per site!" << endl;
+			exit(1);
+		}
+		if (count > 0) {
+			cout << "ERROR: in ChunkedSites::setSiteBits(), packing can only be set while there are no sites!" << endl;
+			exit(1);
+		}
+		bitsPerSite = bits;
+		elementShift = 0;
+		if (bits > 0) {
+			while ((bits << elementShift) < elementBits) {
+				elementShift++;
+			}
+		}
+		elementMask = (1 << elementShift) - 1;
+	}
+
+	int chunkSize() const {
+		return 1 << chunkShift;
+	}
+
+	int siteBits() const {
+		return bitsPerSite;
+	}
+
+	// an empty ChunkedSites with the same chunk size and packing as this one
+	ChunkedSites emptyLike() const {
+		ChunkedSites like;
+		like.chunkShift = chunkShift;
+		like.chunkMask = chunkMask;
+		like.bitsPerSite = bitsPerSite;
+		like.elementShift = elementShift;
+		like.elementMask = elementMask;
+		return like;
+	}
+
+	size_t size() const {
+		return (size_t)count;
+	}
+
+	bool empty() const {
+		return count == 0;
+	}
+
+	T operator[](int index) const {
+		if (bitsPerSite == 0) {
+			return (*chunks[index >> chunkShift])[index & chunkMask];
+		}
+		return getPacked(*chunks[index >> chunkShift], index & chunkMask);
+	}
+
+	// setting a site to the value it already has does nothing (so a shared chunk is not copied)
+	void set(int index, T value) {
+		T oldValue = (*this)[index];
+		if (oldValue == value) {
+			return;
+		}
+		if (bitsPerSite == 0) {
+			writableChunk(index >> chunkShift)[index & chunkMask] = value;
+		} else {
+			int local = index & chunkMask;
+			pack(writableChunk(index >> chunkShift)[local >> elementShift], (local & elementMask) * bitsPerSite, bitsPerSite, value, packable());
+		}
+		if (hashKnown) {
+			sitesHash += siteHash(index, (*this)[index]) - siteHash(index, oldValue);
+		}
+	}
+
+	void clear() {
+		chunks.clear();
+		count = 0;
+		sitesHash = 0;
+		hashKnown = true;
+	}
+
+	// hash of the sites. sites with the same values (in the same order) have the same hash, regardless of chunk size or packing
+	size_t contentHash() {
+		if (!hashKnown) {
+			sitesHash = 0;
+			for (int i = 0; i < count; i++) {
+				sitesHash += siteHash(i, (*this)[i]);
+			}
+			hashKnown = true;
+		}
+		return sitesHash ^ ((size_t)count * 0x9e3779b97f4a7c15ull);
+	}
+
+	void swap(ChunkedSites& other) {
+		chunks.swap(other.chunks);
+		std::swap(count, other.count);
+		std::swap(chunkShift, other.chunkShift);
+		std::swap(chunkMask, other.chunkMask);
+		std::swap(bitsPerSite, other.bitsPerSite);
+		std::swap(elementShift, other.elementShift);
+		std::swap(elementMask, other.elementMask);
+		std::swap(sitesHash, other.sitesHash);
+		std::swap(hashKnown, other.hashKnown);
+	}
+
+	void push_back(T value) {
+		if ((count & chunkMask) == 0) {
+			chunks.push_back(newChunk());
+		}
+		auto& chunk = writableChunk((int)chunks.size() - 1);
+		if (bitsPerSite == 0) {
+			chunk.push_back(value);
+		} else {
+			pushPacked(chunk, count & chunkMask, value);
+		}
+		if (hashKnown) {
+			sitesHash += siteHash(count, (*this)[count]);
+		}
+		count++;
+	}
+
+	// add or remove sites at the end. new sites are value
+	void resize(int newSize, T value = T()) {
+		hashKnown = hashKnown && newSize == count;
+		if (newSize < count) {
+			chunks.resize(newSize == 0 ? 0 : ((newSize - 1) >> chunkShift) + 1);
+			count = newSize;
+			if (newSize > 0) {
+				int local = ((newSize - 1) & chunkMask) + 1;
+				auto& chunk = writableChunk((int)chunks.size() - 1);
+				if (bitsPerSite == 0) {
+					chunk.resize(local);
+				} else {
+					chunk.resize((local + elementMask) >> elementShift);
+					for (int i = local; (i & elementMask) != 0; i++) {  // unused sites in the last element are kept 0 (see operator==)
+						pack(chunk.back(), (i & elementMask) * bitsPerSite, bitsPerSite, T(), packable());
+					}
+				}
+			}
+		}
+		if (bitsPerSite != 0) {
+			while (count < newSize) {
+				push_back(value);
+			}
+		}
+		while (count < newSize) {
+			if ((count & chunkMask) == 0) {
+				chunks.push_back(newChunk());
+			}
+			auto& chunk = writableChunk((int)chunks.size() - 1);
+			int add = min(newSize - count, chunkSize() - (int)chunk.size());
+			chunk.resize(chunk.size() + add, value);
+			count += add;
+		}
+	}
+
+	// append sites [start, start + length) of from. Where whole chunks of from would land on chunk boundaries
+	// they are shared rather than copied
+	void append(const ChunkedSites& from, int start, int length) {
+		hashKnown = hashKnown && length == 0;
+		if (bitsPerSite != from.bitsPerSite) {
+			for (int i = 0; i < length; i++) {
+				push_back(from[start + i]);
+			}
+			return;
+		}
+		while (length > 0) {
+			int fromChunkIndex = start >> from.chunkShift;
+			auto const& fromChunk = from.chunks[fromChunkIndex];
+			int fromSites = from.sitesInChunk(fromChunkIndex);
+			int offset = start & from.chunkMask;
+			if (offset == 0 && (count & chunkMask) == 0 && chunkShift == from.chunkShift && length >= fromSites) {
+				chunks.push_back(fromChunk);
+				count += fromSites;
+				start += fromSites;
+				length -= fromSites;
+				continue;
+			}
+			if ((count & chunkMask) == 0) {
+				chunks.push_back(newChunk());
+			}
+			auto& chunk = writableChunk((int)chunks.size() - 1);
+			int local = count & chunkMask;
+			int take = min({ length, fromSites - offset, chunkSize() - local });
+			if (bitsPerSite == 0) {
+				chunk.insert(chunk.end(), fromChunk->begin() + offset, fromChunk->begin() + offset + take);
+			} else {
+				appendPacked(chunk, local, *fromChunk, offset, take);
+			}
+			count += take;
+			start += take;
+			length -= take;
+		}
+	}
+
+	bool operator==(const ChunkedSites& other) const {
+		if (count != other.count) {
+			return false;
+		}
+		if (chunkShift == other.chunkShift && bitsPerSite == other.bitsPerSite) {
+			for (int i = 0; i < (int)chunks.size(); i++) {
+				if (chunks[i] != other.chunks[i] && *chunks[i] != *other.chunks[i]) {
+					return false;
+				}
+			}
+			return true;
+		}
+		for (int i = 0; i < count; i++) {
+			if ((*this)[i] != other[i]) {
+				return false;
+			}
+		}
+		return true;
+	}
+};
@@ -23,6 +23,8 @@ shared_ptr<ParameterLink<int>> CircularGenomeParameters::mutationDeleteMaxSizePL
 shared_ptr<ParameterLink<int>> CircularGenomeParameters::sizeMinPL = Parameters::register_parameter("GENOME_CIRCULAR-sizeMin", 2000, "if genome is smaller then this, mutations will only increase chromosome size");
 shared_ptr<ParameterLink<int>> CircularGenomeParameters::sizeMaxPL = Parameters::register_parameter("GENOME_CIRCULAR-sizeMax", 20000, "if genome is larger then this, mutations will only decrease chromosome size");
 shared_ptr<ParameterLink<int>> CircularGenomeParameters::mutationCrossCountPL = Parameters::register_parameter("GENOME_CIRCULAR-mutationCrossCount", 3, "number of crosses when performing crossover (including during recombination)");
+shared_ptr<ParameterLink<int>> CircularGenomeParameters::chunkSizePL = Parameters::register_parameter("GENOME_CIRCULAR-chunkSize", 0, "if > 0, sites are stored in blocks of this many sites (must be a power of 2) which offspring share with their parents until the block is mutated. This saves memory when many related genomes are kept (e.g. by LODwAP or SSwD). if 0, each genome stores all of it's sites in one block");
+shared_ptr<ParameterLink<int>> CircularGenomeParameters::bufferPoolSitesPL = Parameters::register_parameter("GENOME_CIRCULAR-bufferPoolSites", 4000000, "site buffers freed when genomes are deleted are kept (up to this many sites in total, per site type) and reused for new genomes. 0 turns off reuse");
 
 // constructor
 template<class T>
@@ -124,11 +126,11 @@ int CircularGenome<T>::Handler::readInt(int valueMin, int valueMax, int code, in
 	}
 	double currentMax = genome->alphabetSize;
 	value = (int) genome->sites[siteIndex];
-	//codingRegions.assignCode(code, siteIndex, CodingRegionIndex);
+	markCodingSite(code, CodingRegionIndex);
 	advanceIndex();  // EOC = end of chromosome
 	while ((valueMax - valueMin + 1) > currentMax) {  // we don't have enough bits of information
 		value = (value * (int)genome->alphabetSize) + (int) genome->sites[siteIndex];  // next site
-		//codingRegions.assignCode(code, siteIndex, CodingRegionIndex);
+		markCodingSite(code, CodingRegionIndex);
 		advanceIndex();
 		currentMax = currentMax * genome->alphabetSize;
 	}
@@ -147,12 +149,83 @@ int CircularGenome<double>::Handler::readInt(int valueMin, int valueMax, int cod
 	}
 	valueMax += 1; // do this so that range is inclusive!
 	value = genome->sites[siteIndex];
+	markCodingSite(code, CodingRegionIndex);
 	advanceIndex();
 	//cout << "  value: " << value << "  valueMin: " << valueMin << "  valueMax: " << valueMax << "  final: " << (value * ((valueMax - valueMin) / genome->alphabetSize)) + valueMin << endl;
 	//cout << "  value: " << value << "  valueMin: " << valueMin << "  valueMax: " << valueMax << "  final: " << ((value / genome->alphabetSize) * (valueMax - valueMin)) + valueMin << endl;
 	return (int)(((value / genome->alphabetSize) * (valueMax - valueMin)) + valueMin);
 }
 
+template<class T>
+int CircularGenome<T>::Handler::sitesPerInt(int valueMin, int valueMax) {
+	int sitesUsed = 1;
+	double currentMax = genome->alphabetSize;
+	while ((valueMax - valueMin + 1) > currentMax) {
+		currentMax = currentMax * genome->alphabetSize;
+		sitesUsed++;
+	}
+	return sitesUsed;
+}
+
+template<>
+int CircularGenome<double>::Handler::sitesPerInt(int valueMin, int valueMax) {
+	return 1;
+}
+
+template<class T>
+void CircularGenome<T>::Handler::readInts(int* values, int count, int valueMin, int valueMax, int code, int CodingRegionIndex) {
+	if (count <= 0) {
+		return;
+	}
+	int k = sitesPerInt(valueMin, valueMax);
+	if (!readDirection || valueMin > valueMax || siteIndex + count * k > (int)genome->size()) {
+		// reading backwards or wrapping around the end of the genome, use readInt()
+		AbstractGenome::Handler::readInts(values, count, valueMin, valueMax, code, CodingRegionIndex);
+		return;
+	}
+	auto const& sites = genome->sites;
+	int range = valueMax - valueMin + 1;
+	int index = siteIndex;
+	markCodingSites(count * k, code, CodingRegionIndex);
+	if (k == 1) {
+		for (int i = 0; i < count; i++) {
+			values[i] = ((int)sites[index + i] % range) + valueMin;
+		}
+	} else {
+		int alphabet = (int)genome->alphabetSize;
+		for (int i = 0; i < count; i++) {
+			int value = (int)sites[index++];
+			for (int j = 1; j < k; j++) {
+				value = (value * alphabet) + (int)sites[index++];
+			}
+			values[i] = (value % range) + valueMin;
+		}
+	}
+	siteIndex += count * k;
+	modulateIndex();
+}
+
+// ints read from a double genome are scaled (see readInt()), so there is no fast path
+template<>
+void CircularGenome<double>::Handler::readInts(int* values, int count, int valueMin, int valueMax, int code, int CodingRegionIndex) {
+	AbstractGenome::Handler::readInts(values, count, valueMin, valueMax, code, CodingRegionIndex);
+}
+
+template<class T>
+void CircularGenome<T>::Handler::skipInts(int count, int valueMin, int valueMax) {
+	if (count <= 0) {
+		return;
+	}
+	int k = sitesPerInt(valueMin, valueMax);
+	if (!readDirection || siteIndex + count * k > (int)genome->size()) {
+		AbstractGenome::Handler::skipInts(count, valueMin, valueMax);
+		return;
+	}
+	markCodingSites(count * k, -1, 0);  // as readInt() would
+	siteIndex += count * k;
+	modulateIndex();
+}
+
 
 template<class T>
 double CircularGenome<T>::Handler::readDouble(double valueMin, double valueMax, int code, int CodingRegionIndex) {
@@ -163,7 +236,7 @@ double CircularGenome<T>::Handler::readDouble(double valueMin, double valueMax,
 		valueMin = temp;
 	}
 	value = (double) genome->sites[siteIndex];
-	//codingRegions.assignCode(code, siteIndex, CodingRegionIndex);
+	markCodingSite(code, CodingRegionIndex);
 	advanceIndex();
 	//scale the value
 	//cout << "  value: " << value << "  valueMin: " << valueMin << "  valueMax: " << valueMax << "  final: " << (value * ((valueMax - valueMin) / genome->alphabetSize)) + valueMin << endl;
@@ -191,7 +264,7 @@ void CircularGenome<T>::Handler::writeInt(int value, int valueMin, int valueMax)
 	}
 	decomposedValue.push_back(value);
 	while ((int)decomposedValue.size() > 0) {  // starting with the last element in decomposedValue, copy into genome.
-		genome->sites[siteIndex] = decomposedValue[(int)decomposedValue.size() - 1];
+		genome->sites.set(siteIndex, decomposedValue[(int)decomposedValue.size() - 1]);
 		advanceIndex();
 		decomposedValue.pop_back();
 	}
@@ -212,7 +285,7 @@ void CircularGenome<double>::Handler::writeInt(int value, int valueMin, int valu
 	//	cout << "ERROR : attempting to write value to <double> Circular Genome. \n value is too large!" << endl;
 	//	exit(1);
 	//}
-	genome->sites[siteIndex] = (((double)(value - valueMin) / (double)(valueMax - valueMin)) * genome->alphabetSize);
+	genome->sites.set(siteIndex, (((double)(value - valueMin) / (double)(valueMax - valueMin)) * genome->alphabetSize));
 	advanceIndex();
 }
 
@@ -231,7 +304,7 @@ void CircularGenome<T>::Handler::writeDouble(double value, double valueMin, doub
 		exit(1);
 	}
 	value = ((value - valueMin) / (valueMax - valueMin)) * genome->alphabetSize;
-	genome->sites[siteIndex] = (T)value;
+	genome->sites.set(siteIndex, (T)value);
 	advanceIndex();
 }
 
@@ -276,7 +349,6 @@ void CircularGenome<T>::Handler::randomize() {
 template<class T>
 vector<vector<int>> CircularGenome<T>::Handler::readTable(pair<int, int> tableSize, pair<int, int> tableMaxSize, pair<int, int> valueRange, int code, int CodingRegionIndex) {
 	vector<vector<int>> table;
-	int x = 0;
 	int y = 0;
 	int Y = tableSize.first;
 	int X = tableSize.second;
@@ -287,19 +359,10 @@ vector<vector<int>> CircularGenome<T>::Handler::readTable(pair<int, int> tableSi
 
 	for (; y < (Y); y++) {
 		table[y].resize(X);  // set the number of columns in this row
-		for (x = 0; x < X; x++) {
-			//table[y][x] = (Type) (sites[index]);
-			table[y][x] = readInt(valueRange.first, valueRange.second, code, CodingRegionIndex);
-		}
-		for (; x < maxX; x++) {
-			readInt(valueRange.first, valueRange.second);  // advance genomeIndex to account for unused entries in the max sized table for this row
-		}
-	}
-	for (; y < (maxY); y++) {
-		for (x = 0; x < maxX; x++) {
-			readInt(valueRange.first, valueRange.second);  // advance to account for unused rows
-		}
+		readInts(table[y].data(), X, valueRange.first, valueRange.second, code, CodingRegionIndex);
+		skipInts(maxX - X, valueRange.first, valueRange.second);  // advance genomeIndex to account for unused entries in the max sized table for this row
 	}
+	skipInts((maxY - Y) * maxX, valueRange.first, valueRange.second);  // advance to account for unused rows
 	return table;
 }
 
@@ -317,6 +380,16 @@ void CircularGenome<T>::setupCircularGenome(int _size, double _alphabetSize) {
 	//sizeMaxLPL = (PT == nullptr) ? CircularGenomeParameters::sizeMaxPL : Parameters::getIntLink("GENOME_CIRCULAR-sizeMax", PT);
 	//mutationCrossCountLPL = (PT == nullptr) ? CircularGenomeParameters::mutationCrossCountPL : Parameters::getIntLink("GENOME_CIRCULAR-mutationCrossCount", PT);
 
+	ChunkedSites<T>::setPoolLimit(CircularGenomeParameters::bufferPoolSitesPL->get(PT));
+	sites.clear();
+	sites.setChunkSize(CircularGenomeParameters::chunkSizePL->get(PT));
+	if (AbstractGenome::genomeSitesTypePL->get(PT) == "packed") {
+		int bits = 1;  // smallest of 1, 2 or 4 bits that can hold all values in the alphabet
+		while ((1 << bits) < _alphabetSize) {
+			bits *= 2;
+		}
+		sites.setSiteBits(bits <= 4 ? bits : 0);
+	}
 	sites.resize(_size);
 	alphabetSize = _alphabetSize;
 	// define columns to be written to genome files
@@ -403,19 +476,19 @@ double CircularGenome<T>::getAlphabetSize() {
 template<class T>
 void CircularGenome<T>::fillRandom() {
 	for (size_t i = 0; i < sites.size(); i++) {
-		sites[i] = (T) Random::getDouble(alphabetSize);
+		sites.set(i, (T) Random::getDouble(alphabetSize));
 	}
 }
 
 template<> inline void CircularGenome<double>::fillRandom() {
 	for (size_t i = 0; i < sites.size(); i++) {
-		sites[i] = Random::getDouble(0, alphabetSize);
+		sites.set(i, Random::getDouble(0, alphabetSize));
 	}
 }
 
 template<> inline void CircularGenome<bool>::fillRandom() {
 	for (size_t i = 0; i < sites.size(); i++) {
-		sites[i] = (bool)((int)Random::getDouble(alphabetSize));
+		sites.set(i, (bool)((int)Random::getDouble(alphabetSize)));
 	}
 }
 
@@ -424,7 +497,7 @@ template<> inline void CircularGenome<bool>::fillRandom() {
 template<class T>
 void CircularGenome<T>::fillAcending() {
 	for (size_t i = 0; i < sites.size(); i++) {
-		sites[i] = ((int)i) % (int) alphabetSize;
+		sites.set(i, ((int)i) % (int) alphabetSize);
 	}
 }
 
@@ -434,7 +507,7 @@ void CircularGenome<T>::fillAcending() {
 template<class T>
 void CircularGenome<T>::fillConstant(int value) {
 	for (size_t i = 0; i < sites.size(); i++) {
-		sites[i] = value;
+		sites.set(i, value);
 	}
 }
 
@@ -446,10 +519,7 @@ template<class T>
 void CircularGenome<T>::copyFrom(shared_ptr<AbstractGenome> from) {
 	auto castFrom = dynamic_pointer_cast<CircularGenome<T>>(from);  // we will be pulling all sorts of stuff from this genome so lets just cast it once.
 	alphabetSize = castFrom->alphabetSize;
-	sites.clear();
-	for (auto site : castFrom->sites) {
-		sites.push_back(site);
-	}
+	sites = castFrom->sites;  // shares the sites until they are changed
 }
 
 // Mutation functions
@@ -467,70 +537,106 @@ bool CircularGenome<T>::isEmpty() {
 
 template<class T>
 void CircularGenome<T>::pointMutate() {
-	sites[Random::getIndex((int)sites.size())] = Random::getIndex((int)alphabetSize);
+	int index = Random::getIndex((int)sites.size());
+	sites.set(index, Random::getIndex((int)alphabetSize));
+	mutationLog.push_back(index);
 }
 
 template<>
 void CircularGenome<double>::pointMutate() {
-	sites[Random::getIndex((int)sites.size())] = Random::getDouble(alphabetSize);
+	int index = Random::getIndex((int)sites.size());
+	sites.set(index, Random::getDouble(alphabetSize));
+	mutationLog.push_back(index);
+}
+
+// point mutate each site with probability rate (see Random::forEachSuccess())
+template<class T>
+void CircularGenome<T>::pointMutateSites(double rate) {
+	uniform_int_distribution<int> siteValue(0, (int)alphabetSize - 1);
+	auto& generator = Random::getCommonGenerator();
+	Random::forEachSuccess((int)sites.size(), rate, [&](int index) {
+		sites.set(index, siteValue(generator));
+		mutationLog.push_back(index);
+	});
+}
+
+template<>
+void CircularGenome<double>::pointMutateSites(double rate) {
+	uniform_real_distribution<double> siteValue(0, alphabetSize);
+	auto& generator = Random::getCommonGenerator();
+	Random::forEachSuccess((int)sites.size(), rate, [&](int index) {
+		sites.set(index, siteValue(generator));
+		mutationLog.push_back(index);
+	});
+}
+
+template<class T>
+void CircularGenome<T>::clearCodingSites() {
+	codingSites.assign(sites.size(), false);
+	codingRegionStarts.clear();
+}
+
+template<class T>
+size_t CircularGenome<T>::contentHash() {
+	return sites.contentHash();  // kept up to date as sites are changed
+}
+
+template<class T>
+bool CircularGenome<T>::sameContent(shared_ptr<AbstractGenome> other) {
+	auto castOther = dynamic_pointer_cast<CircularGenome<T>>(other);
+	return castOther != nullptr && castOther->alphabetSize == alphabetSize && castOther->sites == sites;
 }
 
 // apply mutations to this genome
 template<class T>
 void CircularGenome<T>::mutate() {
-	int howManyPoint = Random::getBinomial((int)sites.size(), CircularGenomeParameters::mutationPointRatePL->get(PT));
 	int howManyCopy = Random::getBinomial((int)sites.size(), CircularGenomeParameters::mutationCopyRatePL->get(PT));
 	int howManyDelete = Random::getBinomial((int)sites.size(), CircularGenomeParameters::mutationDeleteRatePL->get(PT));
 	// do some point mutations
-	for (int i = 0; i < howManyPoint; i++) {
-		pointMutate();
-	}
+	pointMutateSites(CircularGenomeParameters::mutationPointRatePL->get(PT));
+	// sample the copy and delete mutations (tracking only the genome size), then build the new sites in one pass
+	vector<StructuralEdit> edits;
+	int genomeSize = (int)sites.size();
 	// do some copy mutations
 	int MaxGenomeSize = CircularGenomeParameters::sizeMaxPL->get(PT);
 	int IMax = CircularGenomeParameters::mutationCopyMaxSizePL->get(PT);
 	int IMin = CircularGenomeParameters::mutationCopyMinSizePL->get(PT);
-	for (int i = 0; (i < howManyCopy) && (((int)sites.size()) < MaxGenomeSize); i++) {
-		//chromosome->mutateCopy(PT.lookup("mutationCopyMinSize"), PT.lookup("mutationCopyMaxSize"), PT.lookup("chromosomeSizeMax"));
-
-		//cout << "size: " << sites.size() << "->";
-		////shared_ptr<Chromosome<T>> segment = dynamic_pointer_cast<Chromosome<T>>(getSegment(minSize, maxSize));
-
+	for (int i = 0; (i < howManyCopy) && (genomeSize < MaxGenomeSize); i++) {
 		int segmentSize = Random::getInt(IMax - IMin) + IMin;
-		if (segmentSize > (int)sites.size()) {
-			cout << "segmentSize = " << segmentSize << "  sites.size() = " << (int)sites.size() << endl;
+		if (segmentSize > genomeSize) {
+			cout << "segmentSize = " << segmentSize << "  sites.size() = " << genomeSize << endl;
 			cout << "maxSize:minSize" << IMax << ":" << IMin << endl;
 			cout << "ERROR: in curlarGenome<T>::mutate(), segmentSize for insert is > then sites.size()!\nExitting!" << endl;
 			exit(1);
 		}
-		int segmentStart = Random::getInt((int)sites.size() - segmentSize);
-		vector<T> segment;
-		segment.clear();
-		auto it = sites.begin();
-		segment.insert(segment.begin(), it + segmentStart, it + segmentStart + segmentSize);
-
-		////insertSegment(segment);
-		it = sites.begin();
-		sites.insert(it + Random::getInt((int)sites.size()), segment.begin(), segment.end());
-
-		//cout << sites.size() << endl;
+		int segmentStart = Random::getInt(genomeSize - segmentSize);
+		int insertAt = Random::getInt(genomeSize);
+		edits.push_back({ segmentStart, segmentSize, insertAt });
+		genomeSize += segmentSize;
 	}
 	// do some deletion mutations
 	int MinGenomeSize = CircularGenomeParameters::sizeMinPL->get(PT);
 	int DMax = CircularGenomeParameters::mutationDeleteMaxSizePL->get(PT);
 	int DMin = CircularGenomeParameters::mutationDeleteMinSizePL->get(PT);
-	for (int i = 0; (i < howManyDelete) && (((int)sites.size()) > MinGenomeSize); i++) {
-		//chromosome->mutateDelete(PT.lookup("mutationDeletionMinSize"), PT.lookup("mutationDeletionMaxSize"), PT.lookup("chromosomeSizeMin"));
-
+	for (int i = 0; (i < howManyDelete) && (genomeSize > MinGenomeSize); i++) {
 		int segmentSize = Random::getInt(DMax - DMin) + DMin;
-		//cout << "segSize: " << segmentSize << "\tsize: " << sites.size() << "\t->\t";
-		if (segmentSize > (int)sites.size()) {
-			cout << "segmentSize = " << segmentSize << "  sites.size() = " << sites.size() << endl;
+		if (segmentSize > genomeSize) {
+			cout << "segmentSize = " << segmentSize << "  sites.size() = " << genomeSize << endl;
 			cout << "maxSize : minSize   " << DMax << " : " << DMin << endl;
 			cout << "ERROR: in curlarGenome<T>::mutate(), segmentSize for delete is > then sites.size()!\nExitting!" << endl;
 			exit(1);
 		}
-		int segmentStart = Random::getInt(((int)sites.size()) - segmentSize);
-		sites.erase(sites.begin() + segmentStart, sites.begin() + segmentStart + segmentSize);
+		int segmentStart = Random::getInt(genomeSize - segmentSize);
+		edits.push_back({ segmentStart, segmentSize, -1 });
+		genomeSize -= segmentSize;
+	}
+	if (!edits.empty()) {
+		ChunkedSites<T> newSites = sites.emptyLike();
+		for (auto const& segment : replayStructuralEdits((int)sites.size(), edits)) {
+			newSites.append(sites, segment.parentStart, segment.length);
+		}
+		sites.swap(newSites);
+		structuralLog.insert(structuralLog.end(), edits.begin(), edits.end());
 	}
 }
 
@@ -540,7 +646,9 @@ template<class T>
 shared_ptr<AbstractGenome> CircularGenome<T>::makeMutatedGenomeFrom(shared_ptr<AbstractGenome> parent) {
 	auto newGenome = make_shared<CircularGenome<T>>(PT);
 	newGenome->copyFrom(parent);
+	newGenome->mutationLogValid = true; // mutate() will log all changes from parent
 	newGenome->mutate();
+	shareIdentical(newGenome);
 	newGenome->recordDataMap();
 	return newGenome;
 }
@@ -578,10 +686,9 @@ shared_ptr<AbstractGenome> CircularGenome<T>::makeMutatedGenomeFromMany(vector<s
 	} else {
 		//cout << "many parent" << endl;
 
-		// extract the sites list from each parent
-		vector<vector<T>> parentSites;
+		vector<shared_ptr<CircularGenome<T>>> castParents;
 		for (auto parent : parents) {
-			parentSites.push_back(dynamic_pointer_cast<CircularGenome<T>>(parent)->sites);
+			castParents.push_back(dynamic_pointer_cast<CircularGenome<T>>(parent));
 		}
 
 		// randomly determine crossCount number crossLocations
@@ -596,34 +703,67 @@ shared_ptr<AbstractGenome> CircularGenome<T>::makeMutatedGenomeFromMany(vector<s
 
 		sort(crossLocations.begin(), crossLocations.end());  // sort crossLocations
 
-		//cout << "crossing: " << flush;
-		//for (auto location:crossLocations){
-		//	cout << location << "  " << flush;
-		//}
-		//cout << "size init: " << size() << " -> " << flush;
-
+		// pick a parent for each segment. Make sure it's not the same parent twice in a row!
+		vector<int> picks;
 		int pick;
 		int lastPick = Random::getIndex((int)parents.size());
-		newGenome->sites.clear();
 		for (int c = 0; c < ((int)crossLocations.size()) - 1; c++) {
-			// pick a chromosome to cross with. Make sure it's not the same chromosome!
 			pick = Random::getIndex(((int)parents.size()) - 1);
 			if (pick == lastPick) {
 				pick++;
 			}
 			lastPick = pick;
-			// add the segment to this chromosome
-			//cout << "(" << parentSites[pick].size() << ") "<< c << ": " << (int)((double)parentSites[pick].size()*crossLocations[c]) << " " << (int)((double)parentSites[pick].size()*crossLocations[c+1]) << " " << flush;
-			newGenome->sites.insert(newGenome->sites.end(), parentSites[pick].begin() + (int) ((double) parentSites[pick].size() * crossLocations[c]), parentSites[pick].begin() + (int) ((double) parentSites[pick].size() * crossLocations[c + 1]));
-			//cout << " ++ " << flush;
+			picks.push_back(pick);
 		}
+		crossSites(castParents, crossLocations, picks, newGenome->sites);
 	}
 	newGenome->mutate();
+	shareIdentical(newGenome);
 	newGenome->recordDataMap();
 	//cout << "  Leaving Genome::makeMutatedGenome(vector<shared_ptr<AbstractGenome>> parents)\n" << flush;
 	return newGenome;
 }
 
+template<class T>
+void CircularGenome<T>::shareIdentical(shared_ptr<CircularGenome<T>> genome) {
+	if (!AbstractGenome::shareIdenticalPL->get(genome->PT)) {
+		return;
+	}
+	// genomes by contentHash(). genomes are removed from the table (in sweeps) once they are deleted
+	static unordered_multimap<size_t, weak_ptr<CircularGenome<T>>> genomes;
+	static size_t sweepSize = 1024;  // table size which will cause the next sweep
+	size_t hash = genome->contentHash();
+	auto found = genomes.equal_range(hash);
+	for (auto it = found.first; it != found.second; it++) {
+		auto existing = it->second.lock();
+		if (existing && existing->sameContent(genome)) {
+			genome->sites = existing->sites;
+			return;
+		}
+	}
+	if (genomes.size() >= sweepSize) {
+		for (auto it = genomes.begin(); it != genomes.end();) {
+			it = it->second.expired() ? genomes.erase(it) : next(it);
+		}
+		sweepSize = max((size_t)1024, genomes.size() * 2);
+	}
+	genomes.emplace(hash, genome);
+}
+
+// set sites to the parents' sites crossed at crossLocations (fractions of each parent's length, including 0.0 and 1.0).
+// segment c is copied from parents[picks[c]]. whole chunks are shared with the parent where they line up.
+// only the arguments are used, so this may be called for different offspring at the same time
+template<class T>
+void CircularGenome<T>::crossSites(const vector<shared_ptr<CircularGenome<T>>>& parents, const vector<double>& crossLocations, const vector<int>& picks, ChunkedSites<T>& sites) {
+	sites.clear();
+	for (int c = 0; c < (int)picks.size(); c++) {
+		auto const& parentSites = parents[picks[c]]->sites;
+		int segmentStart = (int)((double)parentSites.size() * crossLocations[c]);
+		int segmentEnd = (int)((double)parentSites.size() * crossLocations[c + 1]);
+		sites.append(parentSites, segmentStart, segmentEnd - segmentStart);
+	}
+}
+
 // IO and Data Management functions
 
 // gets data about genome which can be added to a data map
@@ -633,10 +773,15 @@ shared_ptr<AbstractGenome> CircularGenome<T>::makeMutatedGenomeFromMany(vector<s
 template<class T>
 DataMap CircularGenome<T>::getStats(string& prefix) {
 	DataMap dataMap;
-	dataMap.set(prefix + "genomeLength", countSites());
+	addStatsTo(dataMap, prefix);
 	return (dataMap);
 }
 
+template<class T>
+void CircularGenome<T>::addStatsTo(DataMap& dataMap, string& prefix) {
+	dataMap.set(prefix + "genomeLength", countSites());
+}
+
 
 template<class T>
 DataMap CircularGenome<T>::serialize(string& name) {
@@ -646,6 +791,35 @@ DataMap CircularGenome<T>::serialize(string& name) {
 	return serialDataMap;
 }
 
+template<class T>
+DataMap CircularGenome<T>::serialize(string& name, const string& format) {
+	if (format == "text") {
+		return serialize(name);
+	}
+	if (format != "binary" && format != "packed") {
+		cout << "  ERROR :: in CircularGenome<T>::serialize, format \"" << format << "\" is not defined. Use text, binary or packed.\n  exiting" << endl;
+		exit(1);
+	}
+	string bytes;
+	BinaryCoding::putSites<T>(bytes, (int)sites.size(), (format == "packed") ? BinaryCoding::bitsFor(alphabetSize) : 0, [this](int i) {
+		return sites[i];
+	});
+	DataMap serialDataMap;
+	serialDataMap.set(name + "_genomeLength", countSites());
+	serialDataMap.set(name + "_sites", BinaryCoding::toText(bytes));
+	return serialDataMap;
+}
+
+template<class T>
+void CircularGenome<T>::deserializeEncodedSites(const string& encodedSites) {
+	string bytes = BinaryCoding::fromText(encodedSites);
+	size_t pos = 0;
+	sites.clear();
+	BinaryCoding::getSites<T>(bytes, pos, [this](T value) {
+		sites.push_back(value);
+	});
+}
+
 // given a DataMap and PT, return genome [name] from the DataMap
 template<class T>
 void CircularGenome<T>::deserialize(shared_ptr<ParametersTable> PT, unordered_map<string, string>& orgData, string& name) {
@@ -657,6 +831,10 @@ void CircularGenome<T>::deserialize(shared_ptr<ParametersTable> PT, unordered_ma
 		cout << "  In CircularGenome<T>::deserialize :: can not find either GENOME_" + name + "_sites or GENOME_" + name + "_genomeLength.\n  exiting" << endl;
 		exit(1);
 	}
+	if (BinaryCoding::isEncoded(orgData["GENOME_" + name + "_sites"])) {
+		deserializeEncodedSites(orgData["GENOME_" + name + "_sites"]);
+		return;
+	}
 	int genomeLength;
 	load_value(orgData["GENOME_" + name + "_genomeLength"], genomeLength);
 
@@ -690,6 +868,10 @@ void CircularGenome<unsigned char>::deserialize(shared_ptr<ParametersTable> PT,
 		cout << "  In CircularGenome<T>::deserialize :: can not find either GENOME_" + name + "_sites or GENOME_" + name + "_genomeLength.\n  exiting" << endl;
 		exit(1);
 	}
+	if (BinaryCoding::isEncoded(orgData["GENOME_" + name + "_sites"])) {
+		deserializeEncodedSites(orgData["GENOME_" + name + "_sites"]);
+		return;
+	}
 	int genomeLength;
 	load_value(orgData["GENOME_" + name + "_genomeLength"], genomeLength);
 
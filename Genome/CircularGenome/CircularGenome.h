@@ -22,7 +22,9 @@
 #include "../../Utilities/Data.h"
 #include "../../Utilities/Parameters.h"
 #include "../../Utilities/Random.h"
+#include "../../Utilities/BinaryCoding.h"
 #include "../AbstractGenome.h"
+#include "ChunkedSites.h"
 
 using namespace std;
 
@@ -40,6 +42,8 @@ public:
 	static shared_ptr<ParameterLink<int>> sizeMaxPL;
 	static shared_ptr<ParameterLink<int>> sizeMinPL;
 	static shared_ptr<ParameterLink<int>> mutationCrossCountPL;  // number of crosses to make when performing crossover
+	static shared_ptr<ParameterLink<int>> chunkSizePL;
+	static shared_ptr<ParameterLink<int>> bufferPoolSitesPL;
 };
 
 template<class T>
@@ -97,6 +101,11 @@ public:
 
 		virtual void printIndex() override;
 		virtual int readInt(int valueMin, int valueMax, int code = -1, int CodingRegionIndex = 0) override;
+		// readInts and skipInts work directly on the sites if all values can be read forward without reaching the end of the genome
+		virtual void readInts(int* values, int count, int valueMin, int valueMax, int code = -1, int CodingRegionIndex = 0) override;
+		virtual void skipInts(int count, int valueMin, int valueMax) override;
+		// number of sites readInt() uses to read a value in range [min,max]
+		int sitesPerInt(int valueMin, int valueMax);
 		virtual double readDouble(double valueMin, double valueMax, int code = -1, int CodingRegionIndex = 0) override;
 
 		virtual void writeInt(int value, int valueMin, int valueMax) override;
@@ -112,9 +121,43 @@ public:
 		virtual void randomize() override;
 		virtual vector<vector<int>> readTable(pair<int, int> tableSize, pair<int, int> tableMaxSize, pair<int, int> valueRange, int code = -1, int CodingRegionIndex = 0) override;
 
+		virtual int getIndex() override {
+			return siteIndex;
+		}
+
+		// if the genome is tracking coding sites, mark the current site. all reads are marked, with or without a
+		// code, since any site a brain reads can change the brain
+		inline void markCodingSite(int code, int CodingRegionIndex) {
+			if (!genome->codingSites.empty()) {
+				genome->codingSites[siteIndex] = true;
+				markCodingRegionStart(code, CodingRegionIndex);
+			}
+		}
+
+		// markCodingSite() for count sites from the current site, which must not run past the end of the genome
+		inline void markCodingSites(int count, int code, int CodingRegionIndex) {
+			if (!genome->codingSites.empty()) {
+				fill(genome->codingSites.begin() + siteIndex, genome->codingSites.begin() + siteIndex + count, true);
+				markCodingRegionStart(code, CodingRegionIndex);
+			}
+		}
+
+		// record the current site as the start of CodingRegionIndex, if it is the first site read with it
+		inline void markCodingRegionStart(int code, int CodingRegionIndex) {
+			if (code < 0) {
+				return;
+			}
+			auto& starts = genome->codingRegionStarts;
+			if (CodingRegionIndex >= (int)starts.size()) {
+				starts.resize(CodingRegionIndex + 1, -1);
+			}
+			if (starts[CodingRegionIndex] < 0) {
+				starts[CodingRegionIndex] = siteIndex;
+			}
+		}
 	};
 
-	vector<T> sites;
+	ChunkedSites<T> sites;
 	double alphabetSize;
 
 	CircularGenome() = delete;
@@ -169,6 +212,12 @@ public:
 	virtual bool isEmpty() override;
 
 	virtual void pointMutate();
+	virtual void pointMutateSites(double rate);
+
+	virtual void clearCodingSites() override;
+
+	virtual size_t contentHash() override;
+	virtual bool sameContent(shared_ptr<AbstractGenome> other) override;
 
 	// apply mutations to this genome
 	virtual void mutate() override;
@@ -186,19 +235,29 @@ public:
 	// in this case, each parent crosses all of its chromosomes and contributs the result as a new chromosome
 	virtual shared_ptr<AbstractGenome> makeMutatedGenomeFromMany(vector<shared_ptr<AbstractGenome>> parents) override;
 
+	// if GENOME-shareIdentical, give genome the sites of an existing genome with the same content (identical genomes are
+	// then stored once, until one of them is changed)
+	static void shareIdentical(shared_ptr<CircularGenome<T>> genome);
+
+	static void crossSites(const vector<shared_ptr<CircularGenome<T>>>& parents, const vector<double>& crossLocations, const vector<int>& picks, ChunkedSites<T>& sites);
+
 // IO and Data Management functions
 
 // gets data about genome which can be added to a data map
 // data is in pairs of strings (key, value)
 // the undefined action is to return an empty vector
 	virtual DataMap getStats(string& prefix) override;
+	virtual void addStatsTo(DataMap& dataMap, string& prefix) override;
 
 	virtual string getType() override{
 		return "Circular";
 	}
 
 	virtual DataMap serialize(string& name) override;
+	virtual DataMap serialize(string& name, const string& format) override;
 	virtual void deserialize(shared_ptr<ParametersTable> PT, unordered_map<string, string>& orgData, string& name) override;
+	// load sites saved with serialize(name, "binary") or serialize(name, "packed")
+	void deserializeEncodedSites(const string& encodedSites);
 
 	virtual void recordDataMap() override;
 
@@ -231,6 +290,12 @@ inline shared_ptr<AbstractGenome> CircularGenome_genomeFactory(shared_ptr<Parame
 		newGenome = make_shared<CircularGenome<double>>(alphabetSize, sizeInitial, PT);
 	} else if (sitesType == "bool") {
 		newGenome = make_shared<CircularGenome<bool>>(alphabetSize, sizeInitial, PT);
+	} else if (sitesType == "packed") {
+		if (alphabetSize > 16) {
+			cout << "\n\nERROR: genomeSitesType packed requires alphabetSize of 16 or less. current value: " << alphabetSize << "\n\nExiting.\n" << endl;
+			exit(1);
+		}
+		newGenome = make_shared<CircularGenome<unsigned char>>(alphabetSize, sizeInitial, PT);
 	} else {
 		cout << "\n\nERROR: Unrecognized genomeSitesType in configuration!\n  \"" << sitesType << "\" is not defined.\n\nExiting.\n" << endl;
 		exit(1);
@@ -31,6 +31,13 @@ class AbstractChromosome {
 	virtual ~AbstractChromosome() {
 	}
 	virtual bool readInt(int &siteIndex, int &value, int valueMin, int valueMax, bool readDirection, int code = -1, int CodingRegionIndex = 0) = 0;
+	// read up to count values in range [valueMin,valueMax] (valueMin <= valueMax) reading forward from siteIndex, the same
+	// as calls to readInt(), but stop before any value which would reach the last site of the chromosome (that value must be
+	// read with readInt()). if values is nullptr, values are skipped (and not recorded in coding regions)
+	// returns the number of values read. the undefined action is to read nothing
+	virtual int readInts(int &siteIndex, int* values, int count, int valueMin, int valueMax, int code = -1, int CodingRegionIndex = 0) {
+		return 0;
+	}
 	virtual bool writeInt(int &siteIndex, int value, int valueMin, int valueMax, bool readDirection) = 0;
 	virtual bool writeDouble(int &siteIndex, double value, double valueMin, double valueMax, bool readDirection) {
 		cout << "ERROR: writeDouble() in AbstractChromosome was called!\n This has not been implemented yet the chromosome class you are using!\n";
@@ -71,6 +78,18 @@ class AbstractChromosome {
 		exit(1);
 	}
 
+	// add this chromosomes sites to bytes (see BinaryCoding::putSites()). if pack, each site uses as few bits as the alphabet allows
+	virtual void writeSitesBinary(string& bytes, bool pack) {
+		cout << "ERROR: writeSitesBinary(string& bytes, bool pack) in AbstractChromosome was called!\n This has not been implemented yet the chromosome class you are using!\n";
+		exit(1);
+	}
+
+	// replace this chromosomes sites with sites from bytes starting at pos (see BinaryCoding::getSites())
+	virtual void readSitesBinary(const string& bytes, size_t& pos) {
+		cout << "ERROR: readSitesBinary(const string& bytes, size_t& pos) in AbstractChromosome was called!\n This has not been implemented yet the chromosome class you are using!\n";
+		exit(1);
+	}
+
 	virtual string chromosomeToStr() = 0;
 
 	virtual void resize(int size) {
@@ -125,6 +144,11 @@ class AbstractChromosome {
 		exit(1);
 	}
 
+	virtual void mutatePoints(double rate) {
+		cout << "ERROR: mutatePoints(double rate) in AbstractChromosome was called!\n This has not been implemented yet the chromosome class you are using!\n";
+		exit(1);
+	}
+
 	virtual void mutateCopy(int minSize, int maxSize, int chromosomeSizeMax) {
 		cout << "ERROR: mutateCopy(int minSize, int maxSize, int chromosomeSizeMax) in AbstractChromosome was called!\n This has not been implemented yet the chromosome class you are using!\n";
 		exit(1);
@@ -9,6 +9,7 @@
 //         github.com/Hintzelab/MABE/wiki/License
 
 #include "TemplatedChromosome.h"
+#include "../../../Utilities/BinaryCoding.h"
 
 #include <limits>
 
@@ -109,6 +110,68 @@ template<> bool TemplatedChromosome<double>::readInt(int &siteIndex, int &value,
 	return EOC;
 }
 
+template<class T> int TemplatedChromosome<T>::sitesPerInt(int valueMin, int valueMax) {
+	int sitesUsed = 1;
+	double currentMax = alphabetSize;
+	while ((valueMax - valueMin + 1) > currentMax) {
+		currentMax = currentMax * alphabetSize;
+		sitesUsed++;
+	}
+	return sitesUsed;
+}
+
+template<> int TemplatedChromosome<double>::sitesPerInt(int valueMin, int valueMax) {
+	return 1;
+}
+
+// read values directly from sites. only values which end before the last site are read, since readInt() reports
+// the end of the chromosome when it reads the last site
+template<class T> int TemplatedChromosome<T>::readInts(int &siteIndex, int* values, int count, int valueMin, int valueMax, int code, int CodingRegionIndex) {
+	int size = (int)sites.size();
+	if (count <= 0 || siteIndex < 0 || siteIndex >= size) {
+		return 0;
+	}
+	int k = sitesPerInt(valueMin, valueMax);
+	count = min(count, (size - 1 - siteIndex) / k);
+	if (values != nullptr) {
+		int range = valueMax - valueMin + 1;
+		int alphabet = (int)alphabetSize;
+		int index = siteIndex;
+		for (int i = 0; i < count; i++) {
+			int value = (int)sites[index++];
+			for (int j = 1; j < k; j++) {
+				value = (value * alphabet) + (int)sites[index++];
+			}
+			values[i] = (value % range) + valueMin;
+		}
+		if (code >= 0) {
+			for (int i = siteIndex; i < index; i++) {
+				codingRegions.assignCode(code, i, CodingRegionIndex);
+			}
+		}
+	}
+	siteIndex += count * k;
+	return count;
+}
+
+// see readInt() for how ints are read from a double chromosome
+template<> int TemplatedChromosome<double>::readInts(int &siteIndex, int* values, int count, int valueMin, int valueMax, int code, int CodingRegionIndex) {
+	int size = (int)sites.size();
+	if (count <= 0 || siteIndex < 0 || siteIndex >= size) {
+		return 0;
+	}
+	count = min(count, size - 1 - siteIndex);
+	if (values != nullptr) {
+		valueMax += 1;  // do this so that range is inclusive!
+		for (int i = 0; i < count; i++) {
+			values[i] = (int)((sites[siteIndex + i] / alphabetSize) * (valueMax - valueMin)) + valueMin;
+			codingRegions.assignCode(code, siteIndex + i, CodingRegionIndex);
+		}
+	}
+	siteIndex += count;
+	return count;
+}
+
 // writes a value into a chromosome, uses a number of sites baised on valueMin and valueMax);
 // return true if siteIndex went out of range
 template<class T> bool TemplatedChromosome<T>::writeInt(int &siteIndex, int value, int valueMin, int valueMax, bool readDirection) {
@@ -246,6 +309,19 @@ template<class T> void TemplatedChromosome<T>::fillConstant(const int value) {
 	}
 }
 
+template<class T> void TemplatedChromosome<T>::writeSitesBinary(string& bytes, bool pack) {
+	BinaryCoding::putSites<T>(bytes, (int)sites.size(), pack ? BinaryCoding::bitsFor(alphabetSize) : 0, [this](int i) {
+		return sites[i];
+	});
+}
+
+template<class T> void TemplatedChromosome<T>::readSitesBinary(const string& bytes, size_t& pos) {
+	sites.clear();
+	BinaryCoding::getSites<T>(bytes, pos, [this](T value) {
+		sites.push_back(value);
+	});
+}
+
 template<class T> void TemplatedChromosome<T>::readChromosomeFromSS(std::stringstream &ss, int _chromosomeLength) {
 	char nextChar;
 	string nextString;
@@ -402,6 +478,14 @@ template<class T> void TemplatedChromosome<T>::mutatePoint() {
 	sites[Random::getIndex(sites.size())] = (T)Random::getDouble(alphabetSize);
 }
 
+template<class T> void TemplatedChromosome<T>::mutatePoints(double rate) {
+	uniform_real_distribution<double> siteValue(0, alphabetSize);
+	auto& generator = Random::getCommonGenerator();
+	Random::forEachSuccess((int)sites.size(), rate, [&](int index) {
+		sites[index] = (T)siteValue(generator);
+	});
+}
+
 // mutate chromosome by getting a copy of a segment of this chromosome and
 // inserting that segment randomly into this chromosome
 template<class T> void TemplatedChromosome<T>::mutateCopy(int minSize, int maxSize, int chromosomeSizeMax) {
@@ -85,6 +85,9 @@ template<class T> class TemplatedChromosome : public AbstractChromosome {
 	// will use as many sites as needed. works in base alphabetSize
 	// return true if siteIndex went out of range
 	virtual bool readInt(int &siteIndex, int &value, int valueMin, int valueMax, bool readDirection, int code = -1, int CodingRegionIndex = 0) override;
+	virtual int readInts(int &siteIndex, int* values, int count, int valueMin, int valueMax, int code = -1, int CodingRegionIndex = 0) override;
+	// number of sites readInt() uses to read a value in range [valueMin,valueMax] (if it does not reach the end of the chromosome)
+	int sitesPerInt(int valueMin, int valueMax);
 
 	// writes a value into a chromosome, uses a number of sites baised on valueMin and valueMax);
 	// return true if siteIndex went out of range
@@ -113,6 +116,8 @@ template<class T> class TemplatedChromosome : public AbstractChromosome {
 	virtual void fillConstant(const int value) override;
 
 	virtual void readChromosomeFromSS(std::stringstream &ss, int _chromosomeLength) override;
+	virtual void writeSitesBinary(string& bytes, bool pack) override;
+	virtual void readSitesBinary(const string& bytes, size_t& pos) override;
 	// convert a chromosome to a string
 	virtual string chromosomeToStr() override;
 	virtual void resize(int size) override;
@@ -132,6 +137,8 @@ template<class T> class TemplatedChromosome : public AbstractChromosome {
 	// insert from segement into this chromosome. The insertion location is random.
 	virtual void insertSegment(shared_ptr<AbstractChromosome> segment) override;
 	virtual void mutatePoint() override;
+	// point mutate each site with probability rate
+	virtual void mutatePoints(double rate) override;
 	// mutate chromosome by getting a copy of a segment of this chromosome and
 	// inserting that segment randomly into this chromosome
 	virtual void mutateCopy(int minSize, int maxSize, int chromosomeSizeMax) override;
@@ -177,6 +177,36 @@ int MultiGenome::Handler::readInt(int valueMin, int valueMax, int code, int Codi
 	return value;
 }
 
+void MultiGenome::Handler::readInts(int* values, int count, int valueMin, int valueMax, int code, int CodingRegionIndex) {
+	if (!readDirection || valueMin > valueMax) {
+		AbstractGenome::Handler::readInts(values, count, valueMin, valueMax, code, CodingRegionIndex);
+		return;
+	}
+	while (count > 0) {
+		int read = genome->chromosomes[chromosomeIndex]->readInts(siteIndex, values, count, valueMin, valueMax, code, CodingRegionIndex);
+		values += read;
+		count -= read;
+		if (count > 0) {  // the next value reaches the end of the chromosome
+			*values++ = readInt(valueMin, valueMax, code, CodingRegionIndex);
+			count--;
+		}
+	}
+}
+
+void MultiGenome::Handler::skipInts(int count, int valueMin, int valueMax) {
+	if (!readDirection || valueMin > valueMax) {
+		AbstractGenome::Handler::skipInts(count, valueMin, valueMax);
+		return;
+	}
+	while (count > 0) {
+		count -= genome->chromosomes[chromosomeIndex]->readInts(siteIndex, nullptr, count, valueMin, valueMax);
+		if (count > 0) {
+			readInt(valueMin, valueMax);
+			count--;
+		}
+	}
+}
+
 double MultiGenome::Handler::readDouble(double valueMin, double valueMax, int code, int CodingRegionIndex) {
 	double value;
 	if (genome->chromosomes[chromosomeIndex]->siteToDouble(siteIndex, value, valueMin, valueMax, readDirection, code, CodingRegionIndex)) {
@@ -238,7 +268,6 @@ void MultiGenome::Handler::randomize() {
 
 vector<vector<int>> MultiGenome::Handler::readTable(pair<int, int> tableSize, pair<int, int> tableMaxSize, pair<int, int> valueRange, int code, int CodingRegionIndex) {
 	vector<vector<int>> table;
-	int x = 0;
 	int y = 0;
 	int Y = tableSize.first;
 	int X = tableSize.second;
@@ -249,19 +278,10 @@ vector<vector<int>> MultiGenome::Handler::readTable(pair<int, int> tableSize, pa
 
 	for (; y < (Y); y++) {
 		table[y].resize(X);  // set the number of columns in this row
-		for (x = 0; x < X; x++) {
-			//table[y][x] = (Type) (sites[index]);
-			table[y][x] = readInt(valueRange.first, valueRange.second, code, CodingRegionIndex);
-		}
-		for (; x < maxX; x++) {
-			readInt(valueRange.first, valueRange.second);  // advance genomeIndex to account for unused entries in the max sized table for this row
-		}
-	}
-	for (; y < (maxY); y++) {
-		for (x = 0; x < maxX; x++) {
-			readInt(valueRange.first, valueRange.second);  // advance to account for unused rows
-		}
+		readInts(table[y].data(), X, valueRange.first, valueRange.second, code, CodingRegionIndex);
+		skipInts(maxX - X, valueRange.first, valueRange.second);  // advance genomeIndex to account for unused entries in the max sized table for this row
 	}
+	skipInts((maxY - Y) * maxX, valueRange.first, valueRange.second);  // advance to account for unused rows
 	return table;
 }
 
@@ -410,18 +430,16 @@ bool MultiGenome::isEmpty() {
 
 // apply mutations to this genome
 void MultiGenome::mutate() {
+	double pointMutationRate = pointMutationRatePL->get(PT);
 	for (auto chromosome : chromosomes) {
 		int nucleotides = chromosome->size();
 
-		int howManyPoint = Random::getBinomial(nucleotides, pointMutationRatePL->get(PT));
 		int howManyCopy = Random::getBinomial(nucleotides, insertionRatePL->get(PT));
 		int howManyDelete = Random::getBinomial(nucleotides, deletionRatePL->get(PT));
 
 
 		// do some point mutations
-		for (int i = 0; i < howManyPoint; i++) {
-			chromosome->mutatePoint();
-		}
+		chromosome->mutatePoints(pointMutationRate);
 		// do some copy mutations
 		int MaxChromosomeSize = maxChromosomeSizePL->get(PT);
 		int IMax = insertionMaxSizePL->get(PT);
@@ -540,20 +558,42 @@ DataMap MultiGenome::getStats(string& prefix) {
 	return (dataMap);
 }
 
-DataMap MultiGenome::serialize(string& name) {
-	DataMap serialDataMap;
-
+// chromosome lengths as a quoted list, as saved by serialize()
+string MultiGenome::chromosomeLengthsToStr() {
 	string chromosomeLengths = "\"[";
 	for (size_t c = 0; c < chromosomes.size(); c++) {
 		chromosomeLengths += to_string(chromosomes[c]->size()) + ",";
 	}
 	chromosomeLengths.pop_back();
 	chromosomeLengths += "]\"";
-	serialDataMap.set(name + "_chromosomeLengths", chromosomeLengths);
+	return chromosomeLengths;
+}
+
+DataMap MultiGenome::serialize(string& name) {
+	DataMap serialDataMap;
+	serialDataMap.set(name + "_chromosomeLengths", chromosomeLengthsToStr());
 	serialDataMap.set(name + "_sites", genomeToStr());
 	return serialDataMap;
 }
 
+DataMap MultiGenome::serialize(string& name, const string& format) {
+	if (format == "text") {
+		return serialize(name);
+	}
+	if (format != "binary" && format != "packed") {
+		cout << "  ERROR :: in MultiGenome::serialize, format \"" << format << "\" is not defined. Use text, binary or packed.\n  exiting" << endl;
+		exit(1);
+	}
+	string bytes;
+	for (auto chromosome : chromosomes) {
+		chromosome->writeSitesBinary(bytes, format == "packed");
+	}
+	DataMap serialDataMap;
+	serialDataMap.set(name + "_chromosomeLengths", chromosomeLengthsToStr());
+	serialDataMap.set(name + "_sites", BinaryCoding::toText(bytes));
+	return serialDataMap;
+}
+
 // given a DataMap and PT, return genome [name] from the DataMap
 void MultiGenome::deserialize(shared_ptr<ParametersTable> PT, unordered_map<string, string>& orgData, string& name) {
 	// make sure that data has needed columns
@@ -564,6 +604,14 @@ void MultiGenome::deserialize(shared_ptr<ParametersTable> PT, unordered_map<stri
 
 	vector<int> _chromosomeLengths;
 	convertCSVListToVector(orgData["GENOME_" + name + "_chromosomeLengths"], _chromosomeLengths);
+	if (BinaryCoding::isEncoded(orgData["GENOME_" + name + "_sites"])) {
+		string bytes = BinaryCoding::fromText(orgData["GENOME_" + name + "_sites"]);
+		size_t pos = 0;
+		for (size_t i = 0; i < _chromosomeLengths.size(); i++) {
+			chromosomes[i]->readSitesBinary(bytes, pos);
+		}
+		return;
+	}
 	string sitesType = AbstractGenome::genomeSitesTypePL->get(PT);
 	string allSites = orgData["GENOME_" + name + "_sites"].substr(1, orgData["GENOME_" + name + "_sites"].size()-1);
 	std::stringstream ss(allSites);
@@ -22,6 +22,7 @@
 #include "../../Utilities/Data.h"
 #include "../../Utilities/Parameters.h"
 #include "../../Utilities/Random.h"
+#include "../../Utilities/BinaryCoding.h"
 #include "Chromosome/AbstractChromosome.h"
 #include "Chromosome/TemplatedChromosome.h"
 #include "../AbstractGenome.h"
@@ -99,6 +100,9 @@ public:
 		virtual void advanceChromosome();
 		virtual void printIndex() override;
 		virtual int readInt(int valueMin, int valueMax, int code = -1, int CodingRegionIndex = 0) override;
+		// readInts and skipInts read runs of values within a chromosome directly from it's sites (see AbstractChromosome::readInts())
+		virtual void readInts(int* values, int count, int valueMin, int valueMax, int code = -1, int CodingRegionIndex = 0) override;
+		virtual void skipInts(int count, int valueMin, int valueMax) override;
 		virtual double readDouble(double valueMin, double valueMax, int code = -1, int CodingRegionIndex = 0) override;
 
 		virtual void writeInt(int value, int valueMin, int valueMax) override;
@@ -184,7 +188,10 @@ public:
 	virtual string getType() override {
 		return "Multi";
 	}
+
+	string chromosomeLengthsToStr();
 	virtual DataMap serialize(string& name) override;
+	virtual DataMap serialize(string& name, const string& format) override;
 	virtual void deserialize(shared_ptr<ParametersTable> PT, unordered_map<string, string>& orgData, string& name) override;
 
 	virtual void recordDataMap() override;
@@ -26,6 +26,8 @@ shared_ptr<ParameterLink<string>> Global::visualizeOrgIDPL = Parameters::registe
 
 shared_ptr<ParameterLink<string>> Global::outputDirectoryPL = Parameters::register_parameter("GLOBAL-outputDirectory", (string) "./", "where files will be written");
 
+shared_ptr<ParameterLink<int>> Global::organismPoolSizePL = Parameters::register_parameter("GLOBAL-organismPoolSize", 0, "organisms which are no longer used are kept (up to this many) and reused for new organisms. 0 turns off reuse\nif on, organismsAllocated, organismsReused and organismsDeleted are written to the pop file");
+
 //shared_ptr<ParameterLink<string>> Global::groupNameSpacesPL = Parameters::register_parameter("GLOBAL-groups", (string) "[]", "name spaces (also names) of groups to be created (in addition to the default 'no name' space group.)");
 
 //shared_ptr<ParameterLink<int>> Global::bitsPerBrainAddressPL = Parameters::register_parameter("BRAIN-bitsPerBrainAddress", 8, "how many bits are evaluated to determine the brain addresses");
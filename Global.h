@@ -38,6 +38,8 @@ public:
 
 	static shared_ptr<ParameterLink<string>> outputDirectoryPL;  // where files will be written
 
+	static shared_ptr<ParameterLink<int>> organismPoolSizePL;  // how many unused organisms are kept for reuse
+
 	//static shared_ptr<ParameterLink<string>> groupNameSpacesPL;
 
 //	static shared_ptr<ParameterLink<int>> bitsPerBrainAddressPL;  // how many bits are evaluated to determine the brain addresses.
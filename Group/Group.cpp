@@ -11,12 +11,16 @@
 #include "../Group/Group.h"
 
 Group::Group() {  // create an empty Group
+	populationStats = make_shared<PopulationStats>();
 }
 
 Group::Group(vector<shared_ptr<Organism>> _population, shared_ptr<AbstractOptimizer> _optimizer, shared_ptr<DefaultArchivist> _archivist) {
 	population = _population;
 	optimizer = _optimizer;
 	archivist = _archivist;
+	populationStats = make_shared<PopulationStats>();
+	optimizer->populationStats = populationStats;
+	archivist->populationStats = populationStats;
 }
 
 Group::~Group() {
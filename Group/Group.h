@@ -14,6 +14,7 @@
 #include "../Global.h"
 #include "../Optimizer/AbstractOptimizer.h"
 #include "../Organism/Organism.h"
+#include "PopulationStats.h"
 
 using namespace std;
 
@@ -23,6 +24,7 @@ class Group {
 	shared_ptr<Organism> templateOrg;
 	shared_ptr<DefaultArchivist> archivist;
 	shared_ptr<AbstractOptimizer> optimizer;
+	shared_ptr<PopulationStats> populationStats;  // values written by the world and optimizer this update, by population index (also used by archivist)
 
 	Group();
 	Group(vector<shared_ptr<Organism>> _population, shared_ptr<AbstractOptimizer> _optimizer, shared_ptr<DefaultArchivist> _archivist);
@@ -0,0 +1,164 @@
+//  MABE is a product of The Hintze Lab @ MSU
+//     for general research information:
+//         hintzelab.msu.edu
+//     for MABE documentation:
+//         github.com/Hintzelab/MABE/wiki
+//
+//  Copyright (c) 2015 Michigan State University. All rights reserved.
+//     to view the full license, visit:
+//         github.com/Hintzelab/MABE/wiki/License
+
+#pragma once
+
+#include <memory>
+#include <vector>
+
+#include "../Global.h"
+#include "../Organism/Organism.h"
+#include "../Utilities/Data.h"
+
+using namespace std;
+
+// values of a groups organisms for the current update, stored by column. for each data map key which a world or
+// optimizer writes with set() or append() there is one contiguous array with an entry for every organism, indexed by
+// the organisms index in the population. the values are also written to the organisms dataMap (which the max file,
+// lineage and snapshot files still use). the archivist selects some of the organisms (the rows) and makes the pop and
+// max file values as reductions (average(), variance(), sum(), maxIndex()) over these arrays. an organism which was
+// not written this update (i.e. values set at birth, or replayed by AbstractWorld::evaluateSoloCached()) gets the
+// average of key from it's dataMap instead.
+class PopulationStats {
+	struct Column {
+		vector<double> sums;  // sum of the organisms values of key, in the order they were appended
+		vector<int> counts;  // number of values in sums, 0 if the organism has not been written this update
+	};
+	vector<Column> columns;  // indexed by key index (see DataMap::Key::index())
+	int update = -1;  // update the columns were written in
+	vector<size_t> rows;  // index in the population of the organism in each row
+
+	// the column for key, cleared if this is the first write in this update, and with an entry for index
+	Column& columnFor(size_t index, DataMap::Key key) {
+		if (update != Global::update) {
+			for (auto& column : columns) {
+				column.counts.assign(column.counts.size(), 0);
+			}
+			update = Global::update;
+		}
+		if (key.index() >= (int)columns.size()) {
+			columns.resize(key.index() + 1);
+		}
+		Column& column = columns[key.index()];
+		if (index >= column.counts.size()) {
+			column.sums.resize(index + 1);
+			column.counts.resize(index + 1, 0);
+		}
+		return column;
+	}
+
+	// value of key for population[rows[r]] (the same as it's dataMap.getAverage(key))
+	double rowValue(const vector<shared_ptr<Organism>>& population, DataMap::Key key, size_t r) {
+		size_t index = rows[r];
+		if (update == Global::update && key.index() < (int)columns.size() && index < columns[key.index()].counts.size()) {
+			const Column& column = columns[key.index()];
+			if (column.counts[index] > 1) {
+				return column.sums[index] / column.counts[index];
+			}
+			if (column.counts[index] == 1) {
+				return column.sums[index];
+			}
+		}
+		return population[index]->dataMap.getAverage(key);
+	}
+
+public:
+
+	// set key to value for population[index], in it's dataMap and in the column for key
+	template<class T> void set(size_t index, DataMap& dataMap, DataMap::Key key, const T& value) {
+		dataMap.set(key, value);
+		Column& column = columnFor(index, key);
+		column.sums[index] = (double)value;
+		column.counts[index] = 1;
+	}
+
+	// append value to key for population[index], in it's dataMap and in the column for key. the first append this update
+	// starts from the values already in the dataMap (i.e. if the organism was copied, or survived from the last update)
+	template<class T> void append(size_t index, DataMap& dataMap, DataMap::Key key, const T& value) {
+		Column& column = columnFor(index, key);
+		if (column.counts[index] == 0) {
+			column.counts[index] = (int)dataMap.getValueCount(DataMap::keyName(key));
+			column.sums[index] = (column.counts[index] > 0) ? dataMap.getSum(key) : 0;
+		}
+		dataMap.append(key, value);
+		column.sums[index] += (double)value;
+		column.counts[index]++;
+	}
+
+	// select the rows used by the reductions, a row for each organism in population where include(org) is true
+	template<class F> void start(const vector<shared_ptr<Organism>>& population, F include) {
+		rows.clear();
+		for (size_t i = 0; i < population.size(); i++) {
+			if (include(population[i])) {
+				rows.push_back(i);
+			}
+		}
+	}
+
+	size_t rowCount() {
+		return rows.size();
+	}
+
+	// reductions of key over the rows. population must be the population passed to start(), the results are the same as
+	// DataMap::getSum(), getAverage() and getVariance() of a list with the value of each row
+
+	double sum(const vector<shared_ptr<Organism>>& population, DataMap::Key key) {
+		double result = 0;
+		for (size_t r = 0; r < rows.size(); r++) {
+			result += rowValue(population, key, r);
+		}
+		return result;
+	}
+
+	double average(const vector<shared_ptr<Organism>>& population, DataMap::Key key) {
+		double result = sum(population, key);
+		if (rows.size() > 1) {
+			result /= rows.size();
+		}
+		return result;
+	}
+
+	double variance(const vector<shared_ptr<Organism>>& population, DataMap::Key key) {
+		double averageValue = sum(population, key) / rows.size();
+		double result = 0;
+		for (size_t r = 0; r < rows.size(); r++) {
+			double value = rowValue(population, key, r);
+			result += (value - averageValue)*(value - averageValue);
+		}
+		if (rows.size() > 0)
+			result /= rows.size() - 1;
+		else
+			result = 0;
+		return result;
+	}
+
+	// value of key in each row, for output which needs every value (i.e. LIST)
+	vector<double> values(const vector<shared_ptr<Organism>>& population, DataMap::Key key) {
+		vector<double> result(rows.size());
+		for (size_t r = 0; r < rows.size(); r++) {
+			result[r] = rowValue(population, key, r);
+		}
+		return result;
+	}
+
+	// index in population of the row with the highest value for key (the first if there is a tie), -1 if there are no rows
+	int maxIndex(const vector<shared_ptr<Organism>>& population, DataMap::Key key) {
+		int best = -1;
+		double bestValue = 0;
+		for (size_t r = 0; r < rows.size(); r++) {
+			double value = rowValue(population, key, r);
+			if (best < 0 || value > bestValue) {
+				best = (int)r;
+				bestValue = value;
+			}
+		}
+		return (best < 0) ? -1 : (int)rows[best];
+	}
+};
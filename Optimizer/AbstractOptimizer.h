@@ -10,11 +10,13 @@
 
 #pragma once
 
+#include <algorithm>
 #include <iostream>
 #include <stdlib.h>
 #include <vector>
 
 #include "../Genome/AbstractGenome.h"
+#include "../Group/PopulationStats.h"
 #include "../Organism/Organism.h"
 
 #include "../Utilities/Utilities.h"
@@ -35,7 +37,9 @@ class AbstractOptimizer {
 	const shared_ptr<ParametersTable> PT;
 	vector<string> popFileColumns;
 
-	unordered_set <shared_ptr<Organism>> killList; // set of organisms to be killed after archive 
+	vector<bool> killList; // killList[i] is true if population[i] is to be killed after archive (organisms added after killList was made are not killed)
+
+	shared_ptr<PopulationStats> populationStats = make_shared<PopulationStats>(); // values written by optimize() for the pop file (shared with the Group)
 
 	AbstractOptimizer(shared_ptr<ParametersTable> _PT) : PT(_PT) {
 
@@ -45,18 +49,24 @@ class AbstractOptimizer {
 	//virtual vector<shared_ptr<Organism>> makeNextGeneration(vector<shared_ptr<Organism>> &population) = 0;
 	virtual void optimize(vector<shared_ptr<Organism>> &population) = 0;
 
+	// kill the organisms in killList and remove them from population (the order of the remaining organisms is kept)
 	virtual void cleanup(vector<shared_ptr<Organism>> &population) {
-		vector<shared_ptr<Organism>> newPopulation;
-		for (auto org : population) {
-			if (killList.find(org) == killList.end()) { // if not in kill list
-				newPopulation.push_back(org); // move into new population
+		size_t killCount = min(killList.size(), population.size());
+		for (size_t i = 0; i < killCount; i++) {
+			if (killList[i]) {
+				population[i]->kill();
 			}
-			else {
-				org->kill(); // if in kill list, call kill
+		}
+		size_t kept = 0;
+		for (size_t i = 0; i < population.size(); i++) {
+			if (i >= killCount || !killList[i]) { // if not in kill list, move down into the next free place
+				if (kept != i) {
+					population[kept] = move(population[i]);
+				}
+				kept++;
 			}
 		}
-
-		population = newPopulation;
+		population.resize(kept);
 		killList.clear();
 	}
 
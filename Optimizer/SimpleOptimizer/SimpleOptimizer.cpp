@@ -124,8 +124,9 @@ void SimpleOptimizer::optimize(vector<shared_ptr<Organism>> &population) {
 	
 	elites.clear();
 	scores.clear();
-	killList.clear();
+	killList.assign(population.size(), false);
 
+	static const DataMap::Key optimizeValueKey = DataMap::getKey("optimizeValue");
 	for (int i = 0; i < (int)population.size(); i++) {
 		scores.push_back({});
 		if (Random::P(surviveRateMT->eval(population[i]->dataMap, population[i]->PT)[0])) {
@@ -135,7 +136,7 @@ void SimpleOptimizer::optimize(vector<shared_ptr<Organism>> &population) {
 		}
 		else {
 			// they did not survive!
-			killList.insert(population[i]);
+			killList[i] = true;
 		}
 		// for each optimizeValueMT, calculate the score with that MT for this org
 		for (int j = 0; j < (int)optimizeValueMTs.size(); j++) {
@@ -150,9 +151,9 @@ void SimpleOptimizer::optimize(vector<shared_ptr<Organism>> &population) {
 			}
 		}
 		// lastly, save all the optimizeValues to dataMap
-		population[i]->dataMap.set("optimizeValue", scores[i][0]); // we need to have this for the archivist to be able to find max
+		populationStats->set(i, population[i]->dataMap, optimizeValueKey, scores[i][0]); // we need to have this for the archivist to be able to find max
 		for (int j = 1; j < (int)scores[i].size(); j++) {
-			population[i]->dataMap.set("optimizeValue_"+to_string(j), scores[i][j]);
+			populationStats->set(i, population[i]->dataMap, DataMap::getKey("optimizeValue_"+to_string(j)), scores[i][j]);
 		}
 	}
 
@@ -216,9 +217,10 @@ void SimpleOptimizer::optimize(vector<shared_ptr<Organism>> &population) {
 		nextPopulationSize++;
 	}
 	cout << "max = " << to_string(maxScore[0]) << "   ave = " << to_string(aveScore[0]);
-	for (auto org : population) {
-		if (org->timeOfBirth != Global::update) {
-			org->dataMap.set("Simple_numOffspring", org->offspringCount);
+	static const DataMap::Key numOffspringKey = DataMap::getKey("Simple_numOffspring");
+	for (int i = 0; i < (int)population.size(); i++) {
+		if (population[i]->timeOfBirth != Global::update) {
+			populationStats->set(i, population[i]->dataMap, numOffspringKey, Lineage::at(population[i]->lineage).offspringCount);
 		}
 	}
 
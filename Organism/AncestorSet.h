@@ -0,0 +1,132 @@
+//  MABE is a product of The Hintze Lab @ MSU
+//     for general research information:
+//         hintzelab.msu.edu
+//     for MABE documentation:
+//         github.com/Hintzelab/MABE/wiki
+//
+//  Copyright (c) 2015 Michigan State University. All rights reserved.
+//     to view the full license, visit:
+//         github.com/Hintzelab/MABE/wiki/License
+
+#pragma once
+
+#include <algorithm>
+#include <iterator>
+#include <memory>
+#include <unordered_map>
+#include <vector>
+
+using namespace std;
+
+// a set of organism IDs (i.e. the ancestors of an organism which have been saved to a file).
+// sets are immutable and shared: copying a set (i.e. when an offspring inherits it's parents ancestors) only copies a
+// pointer, and a set which is made from IDs (or by union) is looked up in a table of all sets so that identical sets are
+// stored once. IDs are kept sorted, so a set iterates in ID order.
+class AncestorSet {
+	shared_ptr<const vector<int>> ids;  // sorted, without duplicates. nullptr is the empty set
+
+	// all non empty sets, by hash of their IDs. sets are removed from the table (in sweeps) once they are not used
+	static unordered_multimap<size_t, weak_ptr<const vector<int>>>& table() {
+		static unordered_multimap<size_t, weak_ptr<const vector<int>>> sets;
+		return sets;
+	}
+
+	// the shared copy of sortedIDs
+	static shared_ptr<const vector<int>> intern(vector<int>&& sortedIDs) {
+		if (sortedIDs.empty()) {
+			return nullptr;
+		}
+		size_t hash = sortedIDs.size();
+		for (int id : sortedIDs) {
+			hash = hash * 1000003 ^ (size_t)id;
+		}
+		auto& sets = table();
+		auto found = sets.equal_range(hash);
+		for (auto it = found.first; it != found.second; it++) {
+			auto existing = it->second.lock();
+			if (existing && *existing == sortedIDs) {
+				return existing;
+			}
+		}
+		static size_t sweepSize = 1024;  // table size which will cause the next sweep
+		if (sets.size() >= sweepSize) {
+			for (auto it = sets.begin(); it != sets.end();) {
+				it = it->second.expired() ? sets.erase(it) : next(it);
+			}
+			sweepSize = max((size_t)1024, sets.size() * 2);
+		}
+		shared_ptr<const vector<int>> made = make_shared<const vector<int>>(move(sortedIDs));
+		sets.emplace(hash, made);
+		return made;
+	}
+
+	static const vector<int>& noIDs() {
+		static const vector<int> empty;
+		return empty;
+	}
+
+public:
+	AncestorSet() = default;
+
+	explicit AncestorSet(int id) {
+		ids = intern(vector<int>(1, id));
+	}
+
+	// set of IDs in newIDs (which may be in any order and have duplicates)
+	explicit AncestorSet(vector<int> newIDs) {
+		sort(newIDs.begin(), newIDs.end());
+		newIDs.erase(unique(newIDs.begin(), newIDs.end()), newIDs.end());
+		ids = intern(move(newIDs));
+	}
+
+	size_t size() const {
+		return ids ? ids->size() : 0;
+	}
+
+	bool empty() const {
+		return !ids;
+	}
+
+	bool contains(int id) const {
+		return ids && binary_search(ids->begin(), ids->end(), id);
+	}
+
+	// true if id is the only ID in this set (i.e. an organism which has been saved has only itself as an ancestor)
+	bool isOnly(int id) const {
+		return ids && ids->size() == 1 && (*ids)[0] == id;
+	}
+
+	vector<int>::const_iterator begin() const {
+		return ids ? ids->begin() : noIDs().begin();
+	}
+
+	vector<int>::const_iterator end() const {
+		return ids ? ids->end() : noIDs().end();
+	}
+
+	void clear() {
+		ids = nullptr;
+	}
+
+	// make this set the union of this set and other. if either set contains the other, no new set is made
+	void unionWith(const AncestorSet& other) {
+		if (!other.ids || ids == other.ids) {
+			return;
+		}
+		if (!ids) {
+			ids = other.ids;
+			return;
+		}
+		vector<int> merged;
+		merged.reserve(ids->size() + other.ids->size());
+		set_union(ids->begin(), ids->end(), other.ids->begin(), other.ids->end(), back_inserter(merged));
+		if (merged.size() == ids->size()) {
+			return;
+		}
+		if (merged.size() == other.ids->size()) {
+			ids = other.ids;
+			return;
+		}
+		ids = intern(move(merged));
+	}
+};
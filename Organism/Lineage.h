@@ -0,0 +1,219 @@
+//  MABE is a product of The Hintze Lab @ MSU
+//     for general research information:
+//         hintzelab.msu.edu
+//     for MABE documentation:
+//         github.com/Hintzelab/MABE/wiki
+//
+//  Copyright (c) 2015 Michigan State University. All rights reserved.
+//     to view the full license, visit:
+//         github.com/Hintzelab/MABE/wiki/License
+
+#pragma once
+
+#include <memory>
+#include <vector>
+
+#include "AncestorSet.h"
+
+using namespace std;
+
+class Organism;
+
+// the lineage of organisms (who is the parent of who), kept as small records in one arena so that lines of descent
+// can be followed without keeping the organisms (and their data, genomes and brains) which make them up.
+// an organism refers to it's record by index (see Organism::lineage) and records refer to their parents by index.
+// a record is freed (and it's slot is reused) once it's organism is gone and it is not the parent of any record.
+class Lineage {
+public:
+	struct Record {
+		int ID;  // ID of the organism
+		int timeOfBirth;
+		int timeOfDeath;  // -1 while the organism is alive
+		int offspringCount;  // number of offspring (an offspring is removed when it's record is freed)
+		int references;  // 1 while the organism exists + 1 for each record which has this record as a parent
+		int offspringLinks;  // number of records which have this record as a parent
+		int offspringXor;  // xor of the indices of the records which have this record as a parent (see onlyOffspring())
+		int parent;  // index of the first parent, -1 if there are no parents
+		vector<int> moreParents;  // index of the other parents (if there is more then one parent)
+		AncestorSet ancestors;  // see DefaultArchivist::saveSnapshotData() and SSwDArchivist::archive()
+		AncestorSet snapshotAncestors;
+		shared_ptr<Organism> kept;  // the organism, if it is being kept until it is dead and has no offspring (see keep())
+	};
+
+private:
+	struct Arena {
+		vector<Record> records;
+		vector<int> freeIndices;
+		vector<int> unreferenced;  // records to be freed (see freeUnreferenced())
+		vector<shared_ptr<Organism>> released;  // organisms which are no longer kept (see dropReleased())
+	};
+
+	// the arena is never destroyed, so organisms which outlive main() can still release their records
+	static Arena& arena() {
+		static Arena* lineageArena = new Arena();
+		return *lineageArena;
+	}
+
+	// stop keeping the organism of the record at index if it is dead and has no offspring
+	static void checkKept(Record& record) {
+		if (record.kept && record.references == 1 && record.timeOfDeath != -1) {
+			arena().released.push_back(move(record.kept));
+		}
+	}
+
+	// drop a reference to the record at index because offspring (a record) has been unlinked from it
+	static void unlinkOffspring(int index, int offspring, bool offspringGone) {
+		Record& record = at(index);
+		record.offspringLinks--;
+		record.offspringXor ^= offspring;
+		if (offspringGone) {
+			record.offspringCount--;
+		}
+		if (--record.references == 0) {
+			arena().unreferenced.push_back(index);
+		}
+		else {
+			checkKept(record);
+		}
+	}
+
+	// free records which are no longer referenced. the organisms of these records are gone, so each of their parents
+	// loses an offspring (and this may leave a parent unreferenced)
+	static void freeUnreferenced() {
+		auto& unreferenced = arena().unreferenced;
+		while (!unreferenced.empty()) {
+			int index = unreferenced.back();
+			unreferenced.pop_back();
+			Record& record = at(index);
+			if (record.parent != -1) {
+				unlinkOffspring(record.parent, index, true);
+				for (int parent : record.moreParents) {
+					unlinkOffspring(parent, index, true);
+				}
+			}
+			record.parent = -1;
+			record.moreParents.clear();
+			record.ancestors.clear();
+			record.snapshotAncestors.clear();
+			arena().freeIndices.push_back(index);
+		}
+		dropReleased();
+	}
+
+	// let go of organisms which are no longer kept. if an organism is gone, it's record is released (which may
+	// release more organisms), so this is done one organism at a time
+	static void dropReleased() {
+		auto& released = arena().released;
+		while (!released.empty()) {
+			shared_ptr<Organism> org = move(released.back());
+			released.pop_back();
+			org.reset();
+		}
+	}
+
+public:
+	// records are only valid until the next call to add()
+	static Record& at(int index) {
+		return arena().records[index];
+	}
+
+	// make a record (with no parents) for a new organism, returns it's index
+	static int add(int ID, int timeOfBirth) {
+		auto& records = arena().records;
+		auto& freeIndices = arena().freeIndices;
+		int index;
+		if (freeIndices.empty()) {
+			index = (int)records.size();
+			records.emplace_back();
+		}
+		else {
+			index = freeIndices.back();
+			freeIndices.pop_back();
+		}
+		Record& record = records[index];
+		record.ID = ID;
+		record.timeOfBirth = timeOfBirth;
+		record.timeOfDeath = -1;
+		record.offspringCount = 0;
+		record.references = 1;
+		record.offspringLinks = 0;
+		record.offspringXor = 0;
+		record.parent = -1;
+		return index;
+	}
+
+	// the organism with the record at index is gone
+	static void release(int index) {
+		if (--at(index).references == 0) {
+			arena().unreferenced.push_back(index);
+			freeUnreferenced();
+		}
+	}
+
+	// the organism with the record at index has died
+	static void died(int index, int timeOfDeath) {
+		at(index).timeOfDeath = timeOfDeath;
+		checkKept(at(index));
+		dropReleased();
+	}
+
+	// keep org (the organism of the record at index) in memory until it is dead and has no offspring. an archivist can use
+	// this to keep organisms which may be written to a file if they end up on the lineage of a living organism.
+	static void keep(int index, shared_ptr<Organism> org) {
+		Record& record = at(index);
+		if (!record.kept && (record.references > 1 || record.timeOfDeath == -1)) {
+			record.kept = org;
+		}
+	}
+
+	static void addParent(int index, int parent) {
+		Record& record = at(index);
+		if (record.parent == -1) {
+			record.parent = parent;
+		}
+		else {
+			record.moreParents.push_back(parent);
+		}
+		at(parent).offspringCount++;
+		at(parent).references++;
+		at(parent).offspringLinks++;
+		at(parent).offspringXor ^= index;
+	}
+
+	// forget the parents of the record at index (i.e. when lineage before this record is no longer needed)
+	// the parents offspringCount is not changed.
+	static void releaseParents(int index) {
+		Record& record = at(index);
+		if (record.parent != -1) {
+			unlinkOffspring(record.parent, index, false);
+			for (int parent : record.moreParents) {
+				unlinkOffspring(parent, index, false);
+			}
+			record.parent = -1;
+			record.moreParents.clear();
+			freeUnreferenced();
+		}
+	}
+
+	// index of the only record which has the record at index as a parent, -1 if there is not exactly one
+	static int onlyOffspring(int index) {
+		const Record& record = at(index);
+		return (record.offspringLinks == 1) ? record.offspringXor : -1;
+	}
+
+	static int parentCount(int index) {
+		const Record& record = at(index);
+		return (record.parent == -1) ? 0 : 1 + (int)record.moreParents.size();
+	}
+
+	// call f(parentIndex) for each parent of the record at index
+	template<class F> static void forEachParent(int index, F f) {
+		const Record& record = at(index);
+		if (record.parent != -1) {
+			f(record.parent);
+			for (int parent : record.moreParents) {
+				f(parent);
+			}
+		}
+	}
+};
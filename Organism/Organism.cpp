@@ -12,6 +12,7 @@
 
 #include "../Global.h"
 #include "../Organism/Organism.h"
+#include "../Organism/OrganismPool.h"
 
 #include "../Genome/AbstractGenome.h"
 #include "../Utilities/Random.h"
@@ -29,48 +30,36 @@ void Organism::initOrganism(shared_ptr<ParametersTable> _PT) {
 	PT = _PT;
 	ID = registerOrganism();
 	alive = true;
-	offspringCount = 0;  // because it's alive;
 	timeOfBirth = Global::update;  // happy birthday!
 	timeOfDeath = -1;  // still alive
-	dataMap.set("ID", ID);
-	dataMap.set("alive", alive);
-	dataMap.set("timeOfBirth", timeOfBirth);
+	lineage = Lineage::add(ID, timeOfBirth);
+	static const DataMap::Key IDKey = DataMap::getKey("ID");
+	static const DataMap::Key aliveKey = DataMap::getKey("alive");
+	static const DataMap::Key timeOfBirthKey = DataMap::getKey("timeOfBirth");
+	dataMap.set(IDKey, ID);
+	dataMap.set(aliveKey, alive);
+	dataMap.set(timeOfBirthKey, timeOfBirth);
 }
 
 
-/*
- * create an empty organism - it must be filled somewhere else.
- * parents is left empty (this is organism has no parents!)
- */
-Organism::Organism(shared_ptr<ParametersTable> _PT) {
-	initOrganism(_PT);
-	ancestors.insert(ID);  // it is it's own Ancestor for data tracking purposes
-	snapshotAncestors.insert(ID);
-}
-
-/*
-* create a new organism given genomes and brains - the grnome and brains passed with be installed as is (i.e. NOT copied)
-* it is assumed that either this organism will never by used (it will serve as a template), or the brains have already been built elsewhere
-* parents is set left unset/nullptr (no parents), and ancestor is set to self (this organism is the result of adigigenesis!)
-*/
-Organism::Organism(unordered_map<string, shared_ptr<AbstractGenome>>& _genomes, unordered_map<string, shared_ptr<AbstractBrain>>& _brains, shared_ptr<ParametersTable> _PT) {
-	initOrganism(_PT);
-	
-	genomes = _genomes;
-
-	for (auto genome : genomes) { // collect stats from genomes
-		string prefix;
-		(genome.first == "root::") ? prefix = "" : prefix = genome.first;
-		dataMap.merge(genome.second->getStats(prefix));
+// add stats from all genomes and brains to dataMap (stats from "root::" genomes and brains have no prefix)
+void Organism::collectStats() {
+	string prefix;
+	for (auto const& genome : genomes) { // collect stats from genomes
+		prefix = (genome.first == "root::") ? "" : genome.first;
+		genome.second->addStatsTo(dataMap, prefix);
 	}
-
-	brains = _brains;
-
-	for (auto brain : _brains) { // collect stats from brains
-		string prefix;
-		(brain.first == "root::") ? prefix = "" : prefix = brain.first;
-		dataMap.merge(brain.second->getStats(prefix));
+	for (auto const& brain : brains) { // collect stats from brains
+		prefix = (brain.first == "root::") ? "" : brain.first;
+		brain.second->addStatsTo(dataMap, prefix);
 	}
+}
+
+// install genomes and brains (as is, NOT copied), collect their stats and set genome and brain to the "root::" ones
+void Organism::installGenomesAndBrains(unordered_map<string, shared_ptr<AbstractGenome>>&& _genomes, unordered_map<string, shared_ptr<AbstractBrain>>&& _brains) {
+	genomes = move(_genomes);
+	brains = move(_brains);
+	collectStats();
 
 	if (genomes.count("root::") == 0) {
 		genome = nullptr;
@@ -85,104 +74,74 @@ Organism::Organism(unordered_map<string, shared_ptr<AbstractGenome>>& _genomes,
 	else {
 		brain = brains["root::"];
 	}
+}
 
-	ancestors.insert(ID);  // it is it's own Ancestor for data tracking purposes
-	snapshotAncestors.insert(ID);
+/*
+ * create an empty organism - it must be filled somewhere else.
+ * parents is left empty (this is organism has no parents!)
+ */
+Organism::Organism(shared_ptr<ParametersTable> _PT) {
+	init(_PT);
+}
+
+void Organism::init(shared_ptr<ParametersTable> _PT) {
+	initOrganism(_PT);
+	Lineage::at(lineage).ancestors = AncestorSet(ID);  // it is it's own Ancestor for data tracking purposes
+	Lineage::at(lineage).snapshotAncestors = AncestorSet(ID);
 }
 
 /*
-* create a new organism given a single parent, genomes and brains - the grnome and brains passed with be installed as is (i.e. NOT copied)
+* create a new organism given genomes and brains - the grnome and brains passed with be installed as is (i.e. NOT copied)
 * it is assumed that either this organism will never by used (it will serve as a template), or the brains have already been built elsewhere
+* parents is set left unset/nullptr (no parents), and ancestor is set to self (this organism is the result of adigigenesis!)
 */
-Organism::Organism(shared_ptr<Organism> from, unordered_map<string, shared_ptr<AbstractGenome>>& _genomes, unordered_map<string, shared_ptr<AbstractBrain>>& _brains, shared_ptr<ParametersTable> _PT) {
-	initOrganism(_PT);
-
-	genomes = _genomes;
-
-	for (auto genome : genomes) { // collect stats from genomes
-		string prefix;
-		(genome.first == "root::") ? prefix = "" : prefix = genome.first;
-		dataMap.merge(genome.second->getStats(prefix));
-	}
+Organism::Organism(unordered_map<string, shared_ptr<AbstractGenome>> _genomes, unordered_map<string, shared_ptr<AbstractBrain>> _brains, shared_ptr<ParametersTable> _PT) {
+	init(move(_genomes), move(_brains), _PT);
+}
 
-	brains = _brains;
+void Organism::init(unordered_map<string, shared_ptr<AbstractGenome>> _genomes, unordered_map<string, shared_ptr<AbstractBrain>> _brains, shared_ptr<ParametersTable> _PT) {
+	initOrganism(_PT);
+	installGenomesAndBrains(move(_genomes), move(_brains));
 
-	for (auto brain : _brains) { // collect stats from brains
-		string prefix;
-		(brain.first == "root::") ? prefix = "" : prefix = brain.first;
-		dataMap.merge(brain.second->getStats(prefix));
-	}
+	Lineage::at(lineage).ancestors = AncestorSet(ID);  // it is it's own Ancestor for data tracking purposes
+	Lineage::at(lineage).snapshotAncestors = AncestorSet(ID);
+}
 
-	if (genomes.count("root::") == 0) {
-		genome = nullptr;
-	}
-	else {
-		genome = genomes["root::"];
-	}
+/*
+* create a new organism given a single parent, genomes and brains - the grnome and brains passed with be installed as is (i.e. NOT copied)
+* it is assumed that either this organism will never by used (it will serve as a template), or the brains have already been built elsewhere
+*/
+Organism::Organism(shared_ptr<Organism> from, unordered_map<string, shared_ptr<AbstractGenome>> _genomes, unordered_map<string, shared_ptr<AbstractBrain>> _brains, shared_ptr<ParametersTable> _PT) {
+	init(from, move(_genomes), move(_brains), _PT);
+}
 
-	if (brains.count("root::") == 0) {
-		brain = nullptr;
-	}
-	else {
-		brain = brains["root::"];
-	}
+void Organism::init(shared_ptr<Organism> from, unordered_map<string, shared_ptr<AbstractGenome>> _genomes, unordered_map<string, shared_ptr<AbstractBrain>> _brains, shared_ptr<ParametersTable> _PT) {
+	initOrganism(_PT);
+	installGenomesAndBrains(move(_genomes), move(_brains));
 
-	parents.push_back(from);
-	from->offspringCount++;  // this parent has an(other) offspring
-	for (auto ancestorID : from->ancestors) {
-		ancestors.insert(ancestorID);  // union all parents ancestors into this organisms ancestor set.
-	}
-	for (auto ancestorID : from->snapshotAncestors) {
-		snapshotAncestors.insert(ancestorID);  // union all parents ancestors into this organisms ancestor set.
-	}
+	Lineage::addParent(lineage, from->lineage);  // this parent has an(other) offspring
+	Lineage::Record& record = Lineage::at(lineage);
+	record.ancestors = Lineage::at(from->lineage).ancestors;  // a single parent's ancestors are shared, not copied
+	record.snapshotAncestors = Lineage::at(from->lineage).snapshotAncestors;
 }
 
 /*
 * create a new organism given a list of parents, genomes and brains - the grnome and brains passed with be installed as is (i.e. NOT copied)
 * it is assumed that either this organism will never by used (it will serve as a template), or the brains have already been built elsewhere
 */
-Organism::Organism(vector<shared_ptr<Organism>> from, unordered_map<string, shared_ptr<AbstractGenome>>& _genomes, unordered_map<string, shared_ptr<AbstractBrain>>& _brains, shared_ptr<ParametersTable> _PT) {
-	initOrganism(_PT);
-
-	genomes = _genomes;
-
-	for (auto genome : genomes) { // collect stats from genomes
-		string prefix;
-		(genome.first == "root::") ? prefix = "" : prefix = genome.first;
-		dataMap.merge(genome.second->getStats(prefix));
-	}
-
-	brains = _brains;
-
-	for (auto brain : _brains) { // collect stats from brains
-		string prefix;
-		(brain.first == "root::") ? prefix = "" : prefix = brain.first;
-		dataMap.merge(brain.second->getStats(prefix));
-	}
-
-	if (genomes.count("root::") == 0) {
-		genome = nullptr;
-	}
-	else {
-		genome = genomes["root::"];
-	}
+Organism::Organism(vector<shared_ptr<Organism>> from, unordered_map<string, shared_ptr<AbstractGenome>> _genomes, unordered_map<string, shared_ptr<AbstractBrain>> _brains, shared_ptr<ParametersTable> _PT) {
+	init(move(from), move(_genomes), move(_brains), _PT);
+}
 
-	if (brains.count("root::") == 0) {
-		brain = nullptr;
-	}
-	else {
-		brain = brains["root::"];
-	}
+void Organism::init(vector<shared_ptr<Organism>> from, unordered_map<string, shared_ptr<AbstractGenome>> _genomes, unordered_map<string, shared_ptr<AbstractBrain>> _brains, shared_ptr<ParametersTable> _PT) {
+	initOrganism(_PT);
+	installGenomesAndBrains(move(_genomes), move(_brains));
 
+	Lineage::Record& record = Lineage::at(lineage);
 	for (auto parent : from) {
-		parents.push_back(parent);  // add this parent to the parents set
-		parent->offspringCount++;  // this parent has an(other) offspring
-		for (auto ancestorID : parent->ancestors) {
-			ancestors.insert(ancestorID);  // union all parents ancestors into this organisms ancestor set
-		}
-		for (auto ancestorID : parent->snapshotAncestors) {
-			snapshotAncestors.insert(ancestorID);  // union all parents ancestors into this organisms ancestor set.
-		}
+		Lineage::addParent(lineage, parent->lineage);  // add this parent to the parents (this parent has an(other) offspring)
+		record.ancestors.unionWith(Lineage::at(parent->lineage).ancestors);  // union all parents ancestors into this organisms ancestor set
+		record.snapshotAncestors.unionWith(Lineage::at(parent->lineage).snapshotAncestors);
 	}
 }
 
@@ -191,11 +150,21 @@ int Organism::registerOrganism() {
 	return organismIDCounter++;;
 }
 
+// the containers (dataMap, genomes, brains...) are emptied, but keep the memory they use
+void Organism::reset() {
+	dataMap.reset();
+	snapShotDataMaps.clear();
+	evaluationCache = nullptr;
+	genome = nullptr;
+	brain = nullptr;
+	genomes.clear();
+	brains.clear();
+	PT = nullptr;
+	trackOrganism = false;
+}
+
 Organism::~Organism() {
-	for (auto parent : parents) {
-		parent->offspringCount--;  // this parent has one less child in memory
-	}
-	parents.clear();
+	Lineage::release(lineage);  // the record (and so the parents) are kept while this organism has offspring
 }
 
 /*
@@ -204,6 +173,7 @@ Organism::~Organism() {
 void Organism::kill() {
 	alive = false;
 	timeOfDeath = Global::update;
+	Lineage::died(lineage, timeOfDeath);  // if this organism has no offspring, Lineage no longer keeps it
 	if (!trackOrganism) { // if the archivist is not tracking is organism, we can clear it's genomes and brains.
 		genome = nullptr;
 		brain = nullptr;
@@ -226,7 +196,7 @@ shared_ptr<Organism> Organism::makeMutatedOffspringFrom(shared_ptr<Organism> fro
 		newBrains[brain.first]->mutate();
 	}
 	
-	return make_shared<Organism>(from, newGenomes, newBrains, PT);
+	return OrganismPool::make(from, move(newGenomes), move(newBrains), PT);
 }
 
 shared_ptr<Organism> Organism::makeMutatedOffspringFromMany(vector<shared_ptr<Organism>> from) {
@@ -254,28 +224,30 @@ shared_ptr<Organism> Organism::makeMutatedOffspringFromMany(vector<shared_ptr<Or
 		newBrains[brain.first]->mutate();
 	}
 
-	return make_shared<Organism>(from, newGenomes, newBrains, PT);
+	return OrganismPool::make(from, move(newGenomes), move(newBrains), PT);
 }
 
 /*
- * Given a genome return a list of Organisms containing this Organism and all if this Organisms ancestors ordered oldest first
+ * Given a genome return a list of Lineage records (indices) for this Organism and all if this Organisms ancestors ordered oldest first
  * it will fail if any organism in the LOD has more then one parent. (!not for sexual reproduction!)
  */
-vector<shared_ptr<Organism>> Organism::getLOD(shared_ptr<Organism> org) {
-	vector<shared_ptr<Organism>> list;
-
-	list.push_back(org);  // add this organism to the front of the LOD list
-	while (org->parents.size() == 1) {  // while the current org has one and only one parent
-		org = org->parents[0];  // move to the next ancestor (since there is only one parent it is the element in the first position).
-		list.push_back(org);  // add that ancestor to the front of the LOD list
-	}
-	reverse(list.begin(), list.end());
-	for (size_t i = 0; i < list.size(); i++) {
-	}
-	if (org->parents.size() > 1) {  // if more than one parent we have a problem!
+vector<int> Organism::getLOD(shared_ptr<Organism> org) {
+	int index = org->lineage;
+	int length = 1;
+	while (Lineage::parentCount(index) == 1) {  // while the current record has one and only one parent
+		index = Lineage::at(index).parent;  // move to the next ancestor
+		length++;
+	}
+	if (Lineage::parentCount(index) > 1) {  // if more than one parent we have a problem!
 		cout << "In Organism::getLOD(shared_ptr<Organism> org)\n Looks like you have enabled sexual reproduction.\nLOD only works with asexual populations. i.e. an offspring may have at most one parent.\nExiting!\n";
 		exit(1);
 	}
+	vector<int> list(length);
+	index = org->lineage;
+	for (int i = length - 1; i >= 0; i--) {  // fill the list from the back (youngest) to the front (oldest)
+		list[i] = index;
+		index = Lineage::at(index).parent;
+	}
 	return list;
 }
 
@@ -289,25 +261,20 @@ vector<shared_ptr<Organism>> Organism::getLOD(shared_ptr<Organism> org) {
  *       a dead Organism with a referenceCounter = 1 has only one offspring.
  *       a dead Organism with a referenceCounter > 1 has more then one spring with surviving lines of decent.
  */
-shared_ptr<Organism> Organism::getMostRecentCommonAncestor(shared_ptr<Organism> org) {
-	vector<shared_ptr<Organism>> LOD = getLOD(org);  // get line of decent parent "parent"
-	for (auto org : LOD) {  // starting at the oldest parent, moving to the youngest
-		if (org->offspringCount > 1)  // the first (oldest) ancestor with more then one surviving offspring
-			return org;
-	}
-	return org;  // a currently active genome will have referenceCounter = 1 but may be the Most Recent Common Ancestor
+int Organism::getMostRecentCommonAncestor(shared_ptr<Organism> org) {
+	return getMostRecentCommonAncestor(getLOD(org));  // get line of decent parent "parent"
 }
-shared_ptr<Organism> Organism::getMostRecentCommonAncestor(vector<shared_ptr<Organism>> LOD) {
-	for (auto org : LOD) {  // starting at the oldest parent, moving to the youngest
-		if (org->offspringCount > 1)  // the first (oldest) ancestor with more then one surviving offspring
-			return org;
+int Organism::getMostRecentCommonAncestor(const vector<int>& LOD) {
+	for (int index : LOD) {  // starting at the oldest parent, moving to the youngest
+		if (Lineage::at(index).offspringCount > 1)  // the first (oldest) ancestor with more then one surviving offspring
+			return index;
 	}
 	return LOD.back();  // a currently active genome will have referenceCounter = 1 but may be the Most Recent Common Ancestor
 }
 
 
 shared_ptr<Organism> Organism::makeCopy(shared_ptr<ParametersTable> _PT) {
-	auto newOrg = make_shared<Organism>(_PT);
+	auto newOrg = OrganismPool::make(_PT);
 	for (auto genome : genomes) {
 		newOrg->genomes[genome.first] = genome.second->makeCopy(genome.second->PT);
 	}
@@ -331,14 +298,18 @@ shared_ptr<Organism> Organism::makeCopy(shared_ptr<ParametersTable> _PT) {
 
 	newOrg->dataMap = dataMap;
 	newOrg->snapShotDataMaps = snapShotDataMaps;
-	newOrg->offspringCount = offspringCount;
-	newOrg->parents = parents;
-	for (auto parent : parents) {
-		parent->offspringCount++;
-	}
-	newOrg->ancestors = ancestors;
+	newOrg->evaluationCache = evaluationCache;
+	Lineage::forEachParent(lineage, [&newOrg](int parent) {
+		Lineage::addParent(newOrg->lineage, parent);
+	});
+	Lineage::Record& record = Lineage::at(lineage);
+	Lineage::Record& newRecord = Lineage::at(newOrg->lineage);
+	newRecord.offspringCount = record.offspringCount;
+	newRecord.ancestors = record.ancestors;
 	newOrg->timeOfBirth = timeOfBirth;
 	newOrg->timeOfDeath = timeOfDeath;
+	newRecord.timeOfBirth = timeOfBirth;
+	newRecord.timeOfDeath = timeOfDeath;
 	newOrg->alive = alive;
 	return newOrg;
 }
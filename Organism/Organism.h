@@ -18,6 +18,7 @@
 #include "../Genome/AbstractGenome.h"
 
 #include "../Utilities/Data.h"
+#include "Lineage.h"
 #include "../Utilities/Parameters.h"
 
 using namespace std;
@@ -32,6 +33,14 @@ class Organism {
 	map<int, DataMap> snapShotDataMaps;  // Used only with SnapShot with Delay (SSwD) stores contents of dataMap when an ouput interval is reached so that
 	// after the delay we have the correct data for the given time. key is 'update'. This possibly should be wrapped into Archivist.
 
+	// the values which evaluation added to dataMap, so that an organism which has not changed (a survivor or a copy) can
+	// get them again without being evaluated. see AbstractWorld::evaluateSoloCached()
+	struct EvaluationCache {
+		DataMap values;  // values to merge into dataMap
+		vector<string> replacedKeys;  // keys which are cleared from dataMap before merging (i.e. they were set, not appended)
+	};
+	shared_ptr<const EvaluationCache> evaluationCache = nullptr;
+
 	shared_ptr<AbstractGenome> genome = nullptr;
 	shared_ptr<AbstractBrain> brain = nullptr;
 	shared_ptr<ParametersTable> PT;
@@ -39,12 +48,7 @@ class Organism {
 	unordered_map<string, shared_ptr<AbstractGenome>> genomes;
 	unordered_map<string, shared_ptr<AbstractBrain>> brains;
 
-	int offspringCount;
-
-	vector<shared_ptr<Organism>> parents;  // parents are pointers to parents of this organism. In asexual populations this will have one element
-	//unordered_set<int> genomeAncestors;  // list of the IDs of organisms in the last genome file who are ancestors of this organism (genomes saved on genome interval)
-	unordered_set<int> ancestors;  // list of the IDs of organisms in the last data files who are ancestors of this organism (i.e. all files saved on data interval)
-	unordered_set<int> snapshotAncestors;  // like ancestors, but for snapshot files.
+	int lineage;  // index of this organisms record in Lineage (parents, offspring count and ancestors)
 
 	int ID;
 	int timeOfBirth;  // the time this organism was made
@@ -54,6 +58,8 @@ class Organism {
 	bool trackOrganism = false; // if false, genome will be deleted when organism dies.
 
 	void initOrganism(shared_ptr<ParametersTable> _PT);
+	void installGenomesAndBrains(unordered_map<string, shared_ptr<AbstractGenome>>&& _genomes, unordered_map<string, shared_ptr<AbstractBrain>>&& _brains);
+	void collectStats();  // add stats from genomes and brains to dataMap
 
 	Organism() = delete; 
 	Organism(shared_ptr<ParametersTable> _PT = nullptr);  // make an empty organism
@@ -62,10 +68,18 @@ class Organism {
 	//Organism(const vector<shared_ptr<Organism>> from, shared_ptr<AbstractGenome> _genome, shared_ptr<AbstractBrain> _brain, shared_ptr<ParametersTable> _PT = nullptr);  // make a organism with many parents, a genome, and a brain determined from the parents brain type.
 
 
-	Organism(unordered_map<string,shared_ptr<AbstractGenome>>& _genomes, unordered_map<string,shared_ptr<AbstractBrain>>& _brains, shared_ptr<ParametersTable> _PT = nullptr);  // make a parentless organism with a genome, and a brain
-	Organism(shared_ptr<Organism> from, unordered_map<string, shared_ptr<AbstractGenome>>& _genomes, unordered_map<string, shared_ptr<AbstractBrain>>& _brains, shared_ptr<ParametersTable> _PT = nullptr);  // make an organism with one parent, a genome and a brain determined from the parents brain type.
-	Organism(vector<shared_ptr<Organism>> from, unordered_map<string, shared_ptr<AbstractGenome>>& _genomes, unordered_map<string, shared_ptr<AbstractBrain>>& _brains, shared_ptr<ParametersTable> _PT = nullptr);  // make a organism with many parents, a genome, and a brain determined from the parents brain type.
+	Organism(unordered_map<string,shared_ptr<AbstractGenome>> _genomes, unordered_map<string,shared_ptr<AbstractBrain>> _brains, shared_ptr<ParametersTable> _PT = nullptr);  // make a parentless organism with a genome, and a brain
+	Organism(shared_ptr<Organism> from, unordered_map<string, shared_ptr<AbstractGenome>> _genomes, unordered_map<string, shared_ptr<AbstractBrain>> _brains, shared_ptr<ParametersTable> _PT = nullptr);  // make an organism with one parent, a genome and a brain determined from the parents brain type.
+	Organism(vector<shared_ptr<Organism>> from, unordered_map<string, shared_ptr<AbstractGenome>> _genomes, unordered_map<string, shared_ptr<AbstractBrain>> _brains, shared_ptr<ParametersTable> _PT = nullptr);  // make a organism with many parents, a genome, and a brain determined from the parents brain type.
+
 
+	// initialize this organism as the matching constructor would. used by the constructors and OrganismPool::make()
+	// to reuse an organism which has been reset()
+	void init(shared_ptr<ParametersTable> _PT);
+	void init(unordered_map<string, shared_ptr<AbstractGenome>> _genomes, unordered_map<string, shared_ptr<AbstractBrain>> _brains, shared_ptr<ParametersTable> _PT);
+	void init(shared_ptr<Organism> from, unordered_map<string, shared_ptr<AbstractGenome>> _genomes, unordered_map<string, shared_ptr<AbstractBrain>> _brains, shared_ptr<ParametersTable> _PT);
+	void init(vector<shared_ptr<Organism>> from, unordered_map<string, shared_ptr<AbstractGenome>> _genomes, unordered_map<string, shared_ptr<AbstractBrain>> _brains, shared_ptr<ParametersTable> _PT);
+	void reset();  // empty this organism (but not it's Lineage record) so that it can be reused, see OrganismPool
 
 	virtual ~Organism();
 
@@ -79,9 +93,9 @@ class Organism {
 	virtual void kill();  // sets alive = 0 (on org and in dataMap)
 
 	//virtual vector<string> GetLODItem(string key, shared_ptr<Organism> org);
-	virtual vector<shared_ptr<Organism>> getLOD(shared_ptr<Organism> org);
-	virtual shared_ptr<Organism> getMostRecentCommonAncestor(shared_ptr<Organism> org);
-	virtual shared_ptr<Organism> getMostRecentCommonAncestor(vector<shared_ptr<Organism>> LOD);
+	virtual vector<int> getLOD(shared_ptr<Organism> org);  // Lineage record indices, oldest first
+	virtual int getMostRecentCommonAncestor(shared_ptr<Organism> org);
+	virtual int getMostRecentCommonAncestor(const vector<int>& LOD);
 	virtual shared_ptr<Organism> makeMutatedOffspringFrom(shared_ptr<Organism> parent);
 	virtual shared_ptr<Organism> makeMutatedOffspringFromMany(vector<shared_ptr<Organism>> from);
 	virtual shared_ptr<Organism> makeCopy(shared_ptr<ParametersTable> _PT = nullptr);
@@ -0,0 +1,130 @@
+//  MABE is a product of The Hintze Lab @ MSU
+//     for general research information:
+//         hintzelab.msu.edu
+//     for MABE documentation:
+//         github.com/Hintzelab/MABE/wiki
+//
+//  Copyright (c) 2015 Michigan State University. All rights reserved.
+//     to view the full license, visit:
+//         github.com/Hintzelab/MABE/wiki/License
+
+#pragma once
+
+#include <memory>
+#include <utility>
+#include <vector>
+
+#include "Organism.h"
+
+using namespace std;
+
+// organisms which are no longer used, kept so that new organisms do not need to be allocated.
+// organisms made with make() are returned to the pool (by the shared_ptr deleter) when the last shared_ptr to them is
+// gone. they are reset() (so the memory held by their containers is kept) and the next make() initializes one of them
+// in place of a new organism. the shared_ptr control blocks are also reused (see BlockAllocator).
+class OrganismPool {
+public:
+	struct Stats {
+		long long made = 0;  // organisms allocated by make()
+		long long reused = 0;  // organisms from the pool used by make()
+		long long deleted = 0;  // organisms deleted because the pool was full
+	};
+
+private:
+	// allocator for shared_ptr control blocks. blocks are kept for reuse when they are freed
+	template<class T> struct BlockAllocator {
+		typedef T value_type;
+
+		BlockAllocator() = default;
+		template<class U> BlockAllocator(const BlockAllocator<U>&) {
+		}
+
+		// never deleted, so that blocks freed during static destruction can still be returned
+		static vector<T*>& freeBlocks() {
+			static vector<T*>* blocks = new vector<T*>();
+			return *blocks;
+		}
+
+		T* allocate(size_t n) {
+			auto& blocks = freeBlocks();
+			if (n == 1 && !blocks.empty()) {
+				T* block = blocks.back();
+				blocks.pop_back();
+				return block;
+			}
+			return static_cast<T*>(::operator new(n * sizeof(T)));
+		}
+
+		void deallocate(T* block, size_t n) {
+			if (n == 1) {
+				freeBlocks().push_back(block);
+			} else {
+				::operator delete(block);
+			}
+		}
+
+		template<class U> bool operator==(const BlockAllocator<U>&) const {
+			return true;
+		}
+		template<class U> bool operator!=(const BlockAllocator<U>&) const {
+			return false;
+		}
+	};
+
+	struct Pool {
+		vector<Organism*> organisms;
+		size_t limit = 0;
+		Stats stats;
+	};
+
+	// never deleted, so that organisms which outlive main() can still be returned
+	static Pool& pool() {
+		static Pool* organismPool = new Pool();
+		return *organismPool;
+	}
+
+	// shared_ptr deleter for organisms made by make()
+	static void recycle(Organism* org) {
+		auto& organismPool = pool();
+		if (organismPool.organisms.size() < organismPool.limit) {
+			int lineage = org->lineage;
+			org->reset();
+			organismPool.organisms.push_back(org);
+			Lineage::release(lineage);  // this may release (and so recycle) more organisms
+		} else {
+			organismPool.stats.deleted++;
+			delete org;
+		}
+	}
+
+public:
+	// maximum number of organisms kept for reuse (organisms already in the pool are kept). 0 turns off pooling
+	static void setLimit(size_t limit) {
+		pool().limit = limit;
+	}
+
+	static const Stats& stats() {
+		return pool().stats;
+	}
+
+	// number of organisms in the pool
+	static size_t size() {
+		return pool().organisms.size();
+	}
+
+	// make an organism with the constructor for args, or initialize an organism from the pool with Organism::init(args)
+	template<class... Args> static shared_ptr<Organism> make(Args&&... args) {
+		auto& organismPool = pool();
+		Organism* org;
+		if (organismPool.organisms.empty()) {
+			org = new Organism(forward<Args>(args)...);
+			organismPool.stats.made++;
+		} else {
+			org = organismPool.organisms.back();
+			organismPool.organisms.pop_back();
+			org->init(forward<Args>(args)...);
+			organismPool.stats.reused++;
+		}
+		return shared_ptr<Organism>(org, recycle, BlockAllocator<Organism>());
+	}
+};
@@ -0,0 +1,205 @@
+#include "../Utilities/BinaryCoding.h"
+
+#include <vector>
+
+using namespace BinaryCoding;
+
+// putSites() then getSites() on values with bits bits per site, returns the values read
+template<class T>
+vector<T> roundTripSites(const vector<T>& values, int bits) {
+	string bytes;
+	putSites<T>(bytes, (int)values.size(), bits, [&](int i) { return values[i]; });
+	vector<T> result;
+	size_t pos = 0;
+	int count = getSites<T>(bytes, pos, [&](T value) { result.push_back(value); });
+	EXPECT_EQ(count, (int)values.size()) << "getSites() should return the number of sites written";
+	EXPECT_EQ(pos, bytes.size()) << "getSites() should read every byte putSites() wrote";
+	return result;
+}
+
+TEST(putCount, CountRoundTrip) {
+	vector<unsigned long long> counts = { 0, 1, 127, 128, 255, 16383, 16384, 4000000000ull, ~0ull };
+	string bytes;
+	for (auto count : counts) {
+		putCount(bytes, count);
+	}
+	size_t pos = 0;
+	for (auto count : counts) {
+		EXPECT_EQ(getCount(bytes, pos), count) << "getCount() should return " << count;
+	}
+	EXPECT_EQ(pos, bytes.size()) << "getCount() should read every byte putCount() wrote";
+
+	bytes.clear();
+	putCount(bytes, 127);
+	EXPECT_EQ(bytes.size(), 1u) << "counts below 128 should use 1 byte";
+	bytes.clear();
+	putCount(bytes, 128);
+	EXPECT_EQ(bytes.size(), 2u) << "128 should use 2 bytes";
+}
+
+TEST(bitsFor, BitsForAlphabet) {
+	EXPECT_EQ(bitsFor(2), 1) << "alphabet 2 should need 1 bit";
+	EXPECT_EQ(bitsFor(4), 2) << "alphabet 4 should need 2 bits";
+	EXPECT_EQ(bitsFor(5), 3) << "alphabet 5 should need 3 bits";
+	EXPECT_EQ(bitsFor(16), 4) << "alphabet 16 should need 4 bits";
+	EXPECT_EQ(bitsFor(256), 8) << "alphabet 256 should need 8 bits";
+}
+
+TEST(putSites, PackedSitesRoundTrip) {
+	for (int bits : { 1, 2, 4, 8 }) {
+		vector<unsigned char> values;
+		for (int i = 0; i < 1001; i++) {  // odd length so the last byte is partly used
+			values.push_back((unsigned char)((i * 37 + 11) & ((1 << bits) - 1)));
+		}
+		EXPECT_EQ(roundTripSites(values, bits), values) << "unsigned char sites with " << bits << " bits should round trip";
+
+		vector<int> intValues(values.begin(), values.end());
+		EXPECT_EQ(roundTripSites(intValues, bits), intValues) << "int sites with " << bits << " bits should round trip";
+	}
+}
+
+TEST(putSites, RawSitesRoundTrip) {
+	vector<int> intValues = { 0, -1, 42, 1 << 30, -(1 << 30) };
+	EXPECT_EQ(roundTripSites(intValues, 0), intValues) << "raw int sites should round trip";
+
+	vector<double> doubleValues = { 0.0, -1.5, 3.14159, 1e300, -1e-300 };
+	EXPECT_EQ(roundTripSites(doubleValues, 8), doubleValues) << "double sites should be stored raw and round trip";
+}
+
+TEST(putSites, EmptySitesRoundTrip) {
+	for (int bits : { 0, 1, 2, 4, 8 }) {
+		EXPECT_TRUE(roundTripSites(vector<unsigned char>(), bits).empty()) << "empty genome with " << bits << " bits should round trip";
+	}
+	EXPECT_TRUE(roundTripSites(vector<double>(), 0).empty()) << "empty double genome should round trip";
+
+	string bytes;
+	putSites<unsigned char>(bytes, 0, 2, [](int i) { return (unsigned char)0; });
+	string text = toText(bytes);
+	EXPECT_TRUE(isEncoded(text)) << "text of an empty genome should be marked as encoded";
+	EXPECT_EQ(fromText(text), bytes) << "text of an empty genome should round trip";
+}
+
+TEST(toText, TextRoundTrip) {
+	string bytes;
+	for (int length = 0; length < 10; length++) {  // every padding case
+		EXPECT_EQ(fromText(toText(bytes)), bytes) << length << " bytes should round trip through text";
+		bytes.push_back((char)(length * 97 + 200));
+	}
+	string all;
+	for (int i = 0; i < 256; i++) {
+		all.push_back((char)i);
+	}
+	EXPECT_EQ(fromText(toText(all)), all) << "every byte value should round trip through text";
+	EXPECT_EQ(toText("", marker), "#") << "no bytes should be just the marker";
+}
+
+TEST(toDelta, PlainDeltaRoundTrip) {
+	string previous;
+	for (int i = 0; i < 500; i++) {
+		previous += to_string(i * 7919 % 1000) + ",";
+	}
+	auto roundTrip = [&](const string& current, const string& what) {
+		string delta = toDelta(previous, current);
+		EXPECT_TRUE(isDelta(delta)) << what << ": toDelta() should mark its result as a delta";
+		EXPECT_EQ(fromDelta(previous, delta), current) << what << ": fromDelta(previous, toDelta(previous, current)) should be current";
+		return delta;
+	};
+
+	string delta = roundTrip(previous, "identical");
+	EXPECT_LT(delta.size(), 16u) << "identical values should give a short delta";
+	roundTrip(previous.substr(0, 300) + "inserted text" + previous.substr(300), "insertion");
+	roundTrip(previous.substr(0, 300) + previous.substr(450), "deletion");
+	roundTrip(previous.substr(100), "deletion at start");
+	roundTrip(previous.substr(0, previous.size() - 100), "deletion at end");
+	string changed = previous;
+	changed[250] = 'x';
+	roundTrip(changed, "point change");
+	roundTrip(previous.substr(200, 200) + previous, "duplication");
+	roundTrip("", "empty current");
+	roundTrip("short", "short current");
+
+	EXPECT_EQ(fromDelta("", toDelta("", "")), "") << "empty to empty should round trip";
+	EXPECT_EQ(fromDelta("", toDelta("", previous)), previous) << "empty previous should round trip";
+}
+
+TEST(toDelta, EncodedDeltaRoundTrip) {
+	auto encode = [](const vector<unsigned char>& sites) {
+		string bytes;
+		putSites<unsigned char>(bytes, (int)sites.size(), 2, [&](int i) { return sites[i]; });
+		return toText(bytes);
+	};
+	vector<unsigned char> sites;
+	for (int i = 0; i < 2000; i++) {
+		sites.push_back((unsigned char)((i * 2654435761u >> 7) & 3));
+	}
+	string previous = encode(sites);
+	auto roundTrip = [&](const vector<unsigned char>& currentSites, const string& what) {
+		string current = encode(currentSites);
+		string delta = toDelta(previous, current);
+		EXPECT_EQ(fromDelta(previous, delta), current) << what << ": encoded genome should round trip through a delta";
+		return delta;
+	};
+
+	EXPECT_LT(roundTrip(sites, "identical").size(), 16u) << "identical genomes should give a short delta";
+	vector<unsigned char> mutated = sites;
+	mutated[1000] ^= 1;
+	EXPECT_LT(roundTrip(mutated, "point mutation").size(), previous.size() / 4) << "a point mutation should give a short delta";
+	vector<unsigned char> inserted = sites;
+	inserted.insert(inserted.begin() + 700, sites.begin() + 100, sites.begin() + 300);
+	roundTrip(inserted, "insertion");
+	vector<unsigned char> deleted = sites;
+	deleted.erase(deleted.begin() + 500, deleted.begin() + 800);
+	roundTrip(deleted, "deletion");
+	roundTrip(vector<unsigned char>(), "empty genome");
+}
+
+TEST(fromDelta, RejectsDeltaWithWrongBase) {
+	string previous;
+	for (int i = 0; i < 200; i++) {
+		previous += to_string(i) + ",";
+	}
+	string current = previous.substr(0, 100) + "changed" + previous.substr(120);
+	string delta = toDelta(previous, current);
+	string value;
+	EXPECT_TRUE(fromDelta(previous, delta, value)) << "delta should apply to the value it was made from";
+	EXPECT_EQ(value, current) << "delta should make current";
+
+	value = "unset";
+	EXPECT_FALSE(fromDelta("", delta, value)) << "delta should not apply to a missing (empty) previous value";
+	EXPECT_EQ(value, "unset") << "value should not be set when a delta is rejected";
+	EXPECT_FALSE(fromDelta(previous.substr(0, 300), delta, value)) << "delta should not apply to a shorter previous value";
+	EXPECT_FALSE(fromDelta(previous + previous, delta, value)) << "delta should not apply to a longer previous value";
+	EXPECT_FALSE(fromDelta(previous, "not a delta", value)) << "a value without the delta marker should be rejected";
+	EXPECT_FALSE(fromDelta(previous, string(1, deltaMarker), value)) << "an empty delta should be rejected";
+
+	// hand made deltas which copy outside of previous
+	auto makeDelta = [](unsigned long long previousLength, unsigned long long length, unsigned long long start) {
+		string edits(1, (char)0);
+		putCount(edits, previousLength);
+		putCount(edits, length * 2 + 1);
+		putCount(edits, start);
+		return toText(edits, deltaMarker);
+	};
+	EXPECT_TRUE(fromDelta("abcdef", makeDelta(6, 3, 3), value)) << "copy of the end of previous should apply";
+	EXPECT_EQ(value, "def") << "copy of the end of previous should make \"def\"";
+	EXPECT_FALSE(fromDelta("abcdef", makeDelta(6, 4, 3), value)) << "copy past the end of previous should be rejected";
+	EXPECT_FALSE(fromDelta("abcdef", makeDelta(6, 1, 6), value)) << "copy starting at the end of previous should be rejected";
+	EXPECT_FALSE(fromDelta("abcdef", makeDelta(6, 2, ~0ull), value)) << "copy with a start which overflows should be rejected";
+	EXPECT_FALSE(fromDelta("abcdef", makeDelta(6, ~0ull >> 1, 2), value)) << "copy with a length which overflows should be rejected";
+
+	string truncated = fromText(delta);
+	truncated.resize(truncated.size() - 1);
+	EXPECT_FALSE(fromDelta(previous, toText(truncated, deltaMarker), value)) << "a truncated delta should be rejected";
+
+	EXPECT_EXIT(fromDelta("", delta), ::testing::ExitedWithCode(1), "") << "fromDelta() without a result should exit on a bad delta";
+}
+
+TEST(fromDelta, RejectsEncodedDeltaOnPlainValue) {
+	string bytes;
+	putSites<unsigned char>(bytes, 100, 2, [](int i) { return (unsigned char)(i & 3); });
+	string previous = toText(bytes);
+	string delta = toDelta(previous, previous);
+	string value;
+	EXPECT_TRUE(fromDelta(previous, delta, value)) << "encoded delta should apply to the encoded value it was made from";
+	EXPECT_FALSE(fromDelta(previous.substr(1), delta, value)) << "encoded delta should not apply to a value which is not encoded";
+}
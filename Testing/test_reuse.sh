@@ -0,0 +1,52 @@
+#!/bin/bash
+# runs MABE with BRAIN-reuseOnSilentMutations on and off and checks that the output files are the same.
+# reusing (or incrementally rebuilding) a parent's brain must build the brain a full decode of the genome would.
+# each Markov gate type is checked alone and with all gate types together. run from Testing after building ../mabe
+# usage: ./test_reuse.sh [updates]
+
+MABE=$(cd .. && pwd)/mabe
+UPDATES=${1:-30}
+GATES="DETERMINISTIC PROBABILISTIC EPSILON VOID GENETICPROGRAMING TRIT NEURON FEEDBACK DECOMPOSABLE DECOMPOSABLE_FEEDBACK"
+FAILED=0
+
+# run "name" "parameters" with reuse on and off and compare
+check() {
+	for reuse in 0 1; do
+		rm -rf reuse_$reuse
+		mkdir reuse_$reuse
+		ln -s ../../World reuse_$reuse/World
+		(cd reuse_$reuse && $MABE -p GLOBAL-randomSeed 7 GLOBAL-updates $UPDATES $2 BRAIN-reuseOnSilentMutations $reuse > run.log 2>&1)
+		if [ $? -ne 0 ]; then
+			echo "FAILED (run) : $1 (reuse $reuse)"
+			tail -3 reuse_$reuse/run.log
+			FAILED=1
+			return
+		fi
+	done
+	if diff -q reuse_0/pop.csv reuse_1/pop.csv > /dev/null && diff -q reuse_0/max.csv reuse_1/max.csv > /dev/null; then
+		echo "ok     : $1"
+	else
+		echo "FAILED : $1"
+		FAILED=1
+	fi
+	rm -rf reuse_0 reuse_1
+}
+
+MARKOV="WORLD-worldType Xor BRAIN-brainType Markov ARCHIVIST-outputMethod Default"
+ALL=""
+for gate in $GATES; do
+	OTHERS=""
+	if [ $gate != DETERMINISTIC ]; then
+		OTHERS="BRAIN_MARKOV_GATES_DETERMINISTIC-allow 0"
+	fi
+	check "Markov $gate gates" "$MARKOV $OTHERS BRAIN_MARKOV_GATES_$gate-allow 1"
+	if [ $gate != DETERMINISTIC ]; then
+		ALL="$ALL BRAIN_MARKOV_GATES_$gate-allow 1"
+	fi
+done
+check "Markov all gates" "$MARKOV $ALL"
+check "Markov all gates, copy and delete mutations" "$MARKOV $ALL GENOME_CIRCULAR-mutationCopyRate 0.0005 GENOME_CIRCULAR-mutationDeleteRate 0.0005"
+check "CGP" "WORLD-worldType Xor BRAIN-brainType CGP ARCHIVIST-outputMethod Default"
+check "ConstantValues" "BRAIN-brainType ConstantValues ARCHIVIST-outputMethod Default"
+
+exit $FAILED
@@ -2,6 +2,7 @@
 #include <iostream>
 
 #include "test_graycode.h"
+#include "test_binarycoding.h"
 
 int main(int argc, char* argv[]) {
 	testing::InitGoogleTest(&argc, argv);
@@ -0,0 +1,360 @@
+//  MABE is a product of The Hintze Lab @ MSU
+//     for general research information:
+//         hintzelab.msu.edu
+//     for MABE documentation:
+//         github.com/Hintzelab/MABE/wiki
+//
+//  Copyright (c) 2015 Michigan State University. All rights reserved.
+//     to view the full license, visit:
+//         github.com/Hintzelab/MABE/wiki/License
+
+#pragma once
+
+#include <cstring>
+#include <iostream>
+#include <string>
+#include <type_traits>
+#include <unordered_map>
+
+using namespace std;
+
+// binary encoding for genome sites (and other lists of values) saved in organisms files.
+// a list of sites is stored as: count, bits per site, then the sites. If bits per site is 0 each site is stored
+// as it's raw bytes, otherwise sites are packed into a bit stream using bits per site bits each.
+// counts are stored 7 bits per byte (the high bit is set on all but the last byte).
+// so that encoded data can be stored in a csv file with other data, it is converted to text with base64,
+// and marked with a leading '#' (see toText() and isEncoded())
+namespace BinaryCoding {
+
+const char marker = '#';
+
+inline void putCount(string& bytes, unsigned long long value) {
+	while (value >= 0x80) {
+		bytes.push_back((char)((value & 0x7f) | 0x80));
+		value >>= 7;
+	}
+	bytes.push_back((char)value);
+}
+
+// read a count written by putCount() starting at pos. returns false if the data ends first (or the count is too long)
+inline bool tryGetCount(const string& bytes, size_t& pos, unsigned long long& value) {
+	value = 0;
+	for (int shift = 0; shift < 64 && pos < bytes.size(); shift += 7) {
+		unsigned char byte = (unsigned char)bytes[pos++];
+		value |= (unsigned long long)(byte & 0x7f) << shift;
+		if ((byte & 0x80) == 0) {
+			return true;
+		}
+	}
+	return false;
+}
+
+inline unsigned long long getCount(const string& bytes, size_t& pos) {
+	unsigned long long value;
+	if (!tryGetCount(bytes, pos, value)) {
+		cout << "  ERROR :: in BinaryCoding::getCount(), encoded data ended unexpectedly.\n  Exiting." << endl;
+		exit(1);
+	}
+	return value;
+}
+
+// smallest number of bits which can hold values in [0, alphabetSize)
+inline int bitsFor(double alphabetSize) {
+	int bits = 1;
+	while ((double)(1ull << bits) < alphabetSize && bits < 63) {
+		bits++;
+	}
+	return bits;
+}
+
+// add count sites (get(i) is site i) to bytes. bits = 0 stores raw sites. sites which are not integers are always raw
+template<class T, class Get>
+void putSites(string& bytes, int count, int bits, Get get) {
+	if (!is_integral<T>::value) {
+		bits = 0;
+	}
+	putCount(bytes, (unsigned long long)count);
+	putCount(bytes, (unsigned long long)bits);
+	if (bits == 0) {
+		size_t start = bytes.size();
+		bytes.resize(start + (size_t)count * sizeof(T));
+		for (int i = 0; i < count; i++) {
+			T value = get(i);
+			memcpy(&bytes[start + (size_t)i * sizeof(T)], &value, sizeof(T));
+		}
+		return;
+	}
+	unsigned long long buffer = 0;
+	int buffered = 0;
+	unsigned long long mask = (bits == 64) ? ~0ull : ((1ull << bits) - 1);
+	for (int i = 0; i < count; i++) {
+		unsigned long long value = (unsigned long long)get(i) & mask;
+		buffer |= value << buffered;
+		int used = min(bits, 64 - buffered);
+		buffered += used;
+		while (buffered >= 8) {
+			bytes.push_back((char)(buffer & 0xff));
+			buffer >>= 8;
+			buffered -= 8;
+		}
+		if (used < bits) {  // part of value did not fit in buffer
+			buffer |= value >> used << buffered;
+			buffered += bits - used;
+		}
+	}
+	if (buffered > 0) {
+		bytes.push_back((char)(buffer & 0xff));
+	}
+}
+
+// read sites written by putSites() starting at pos, calling put(value) for each site. returns the number of sites
+template<class T, class Put>
+int getSites(const string& bytes, size_t& pos, Put put) {
+	int count = (int)getCount(bytes, pos);
+	int bits = (int)getCount(bytes, pos);
+	size_t needed = (bits == 0) ? (size_t)count * sizeof(T) : ((size_t)count * bits + 7) / 8;
+	if (pos + needed > bytes.size()) {
+		cout << "  ERROR :: in BinaryCoding::getSites(), encoded data ended unexpectedly.\n  Exiting." << endl;
+		exit(1);
+	}
+	if (bits == 0) {
+		for (int i = 0; i < count; i++) {
+			T value;
+			memcpy(&value, &bytes[pos + (size_t)i * sizeof(T)], sizeof(T));
+			put(value);
+		}
+	} else {
+		size_t bitPos = 0;
+		const unsigned char* data = (const unsigned char*)bytes.data() + pos;
+		for (int i = 0; i < count; i++) {
+			unsigned long long value = 0;
+			for (int b = 0; b < bits;) {
+				int offset = (int)(bitPos & 7);
+				int take = min(bits - b, 8 - offset);
+				value |= (unsigned long long)((data[bitPos >> 3] >> offset) & ((1 << take) - 1)) << b;
+				b += take;
+				bitPos += take;
+			}
+			put((T)value);
+		}
+	}
+	pos += needed;
+	return count;
+}
+
+inline bool isEncoded(const string& text) {
+	return !text.empty() && text[0] == marker;
+}
+
+// bytes as text which can be saved in a csv file
+inline string toText(const string& bytes, char textMarker = marker) {
+	static const char digits[] = "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/";
+	string text(1, textMarker);
+	text.reserve(1 + ((bytes.size() + 2) / 3) * 4);
+	size_t i = 0;
+	for (; i + 2 < bytes.size(); i += 3) {
+		unsigned int group = ((unsigned char)bytes[i] << 16) | ((unsigned char)bytes[i + 1] << 8) | (unsigned char)bytes[i + 2];
+		text.push_back(digits[(group >> 18) & 63]);
+		text.push_back(digits[(group >> 12) & 63]);
+		text.push_back(digits[(group >> 6) & 63]);
+		text.push_back(digits[group & 63]);
+	}
+	if (i < bytes.size()) {
+		unsigned int group = (unsigned char)bytes[i] << 16;
+		if (i + 1 < bytes.size()) {
+			group |= (unsigned char)bytes[i + 1] << 8;
+		}
+		text.push_back(digits[(group >> 18) & 63]);
+		text.push_back(digits[(group >> 12) & 63]);
+		text.push_back((i + 1 < bytes.size()) ? digits[(group >> 6) & 63] : '=');
+		text.push_back('=');
+	}
+	return text;
+}
+
+// convert text made by toText() back to bytes (the leading marker is skipped)
+inline string fromText(const string& text) {
+	string bytes;
+	bytes.reserve((text.size() / 4) * 3);
+	unsigned int group = 0;
+	int digitCount = 0;
+	for (size_t i = 1; i < text.size() && text[i] != '='; i++) {
+		char c = text[i];
+		int digit;
+		if (c >= 'A' && c <= 'Z') {
+			digit = c - 'A';
+		} else if (c >= 'a' && c <= 'z') {
+			digit = c - 'a' + 26;
+		} else if (c >= '0' && c <= '9') {
+			digit = c - '0' + 52;
+		} else if (c == '+') {
+			digit = 62;
+		} else if (c == '/') {
+			digit = 63;
+		} else {
+			cout << "  ERROR :: in BinaryCoding::fromText(), found '" << c << "' in encoded data.\n  Exiting." << endl;
+			exit(1);
+		}
+		group = (group << 6) | digit;
+		digitCount++;
+		if (digitCount == 4) {
+			bytes.push_back((char)((group >> 16) & 0xff));
+			bytes.push_back((char)((group >> 8) & 0xff));
+			bytes.push_back((char)(group & 0xff));
+			group = 0;
+			digitCount = 0;
+		}
+	}
+	if (digitCount >= 2) {
+		group <<= 6 * (4 - digitCount);
+		bytes.push_back((char)((group >> 16) & 0xff));
+		if (digitCount == 3) {
+			bytes.push_back((char)((group >> 8) & 0xff));
+		}
+	}
+	return bytes;
+}
+
+// delta coding - a value (e.g. a genome in a line of descent file) saved as the edits which make it from a previous value.
+// the edits are copies of runs of the previous value and runs of new (literal) data, so point mutations, copies and
+// deletions all cost a few bytes. encoded values (see toText()) are compared as bytes so runs line up with sites.
+// a delta is stored as deltaMarker followed by base64 of: 1 if the values are encoded (0 if not), the length of
+// the previous value (so a delta applied to the wrong value can be caught), then the edits.
+// a copy edit is (length * 2 + 1), start. a literal edit is (length * 2) followed by length bytes.
+const char deltaMarker = '~';
+
+inline bool isDelta(const string& text) {
+	return !text.empty() && text[0] == deltaMarker;
+}
+
+// edits which make current from previous
+inline string toDelta(const string& previous, const string& current) {
+	bool encoded = isEncoded(previous) && isEncoded(current);
+	string from = encoded ? fromText(previous) : previous;
+	string to = encoded ? fromText(current) : current;
+
+	const int blockSize = 16;  // shortest run which will be found
+	const unsigned long long base = 1099511628211ull;
+	unsigned long long basePower = 1;  // base ^ (blockSize - 1), to remove the oldest byte from a rolling hash
+	for (int i = 1; i < blockSize; i++) {
+		basePower *= base;
+	}
+	auto hashFrom = [&](const string& bytes, size_t start) {
+		unsigned long long hash = 0;
+		for (int i = 0; i < blockSize; i++) {
+			hash = hash * base + (unsigned char)bytes[start + i];
+		}
+		return hash;
+	};
+
+	// index every block in from
+	unordered_map<unsigned long long, int> blocks;
+	if (from.size() >= (size_t)blockSize) {
+		blocks.reserve(from.size());
+		unsigned long long hash = hashFrom(from, 0);
+		for (size_t i = 0;; i++) {
+			blocks.emplace(hash, (int)i);
+			if (i + blockSize >= from.size()) {
+				break;
+			}
+			hash = (hash - (unsigned char)from[i] * basePower) * base + (unsigned char)from[i + blockSize];
+		}
+	}
+
+	string edits(1, encoded ? (char)1 : (char)0);
+	putCount(edits, (unsigned long long)from.size());
+	size_t literalStart = 0;
+	auto putLiteral = [&](size_t end) {
+		if (end > literalStart) {
+			putCount(edits, (unsigned long long)(end - literalStart) * 2);
+			edits.append(to, literalStart, end - literalStart);
+		}
+	};
+	size_t j = 0;
+	bool hashValid = false;
+	unsigned long long hash = 0;
+	while (j + blockSize <= to.size()) {
+		hash = hashValid ? (hash - (unsigned char)to[j - 1] * basePower) * base + (unsigned char)to[j + blockSize - 1] : hashFrom(to, j);
+		hashValid = true;
+		auto found = blocks.find(hash);
+		if (found != blocks.end() && from.compare(found->second, blockSize, to, j, blockSize) == 0) {
+			size_t start = found->second;
+			size_t length = blockSize;
+			while (start + length < from.size() && j + length < to.size() && from[start + length] == to[j + length]) {
+				length++;
+			}
+			while (start > 0 && j > literalStart && from[start - 1] == to[j - 1]) {  // extend back into the literal
+				start--;
+				j--;
+				length++;
+			}
+			putLiteral(j);
+			putCount(edits, (unsigned long long)length * 2 + 1);
+			putCount(edits, (unsigned long long)start);
+			j += length;
+			literalStart = j;
+			hashValid = false;
+		} else {
+			j++;
+		}
+	}
+	putLiteral(to.size());
+	return toText(edits, deltaMarker);
+}
+
+// apply delta (from toDelta()) to previous, setting value. returns false (and leaves value unset) if delta is
+// damaged or was not made from previous (e.g. a copy falls outside of previous)
+inline bool fromDelta(const string& previous, const string& delta, string& value) {
+	if (!isDelta(delta)) {
+		return false;
+	}
+	string edits = fromText(delta);
+	if (edits.empty() || (edits[0] != 0 && edits[0] != 1)) {
+		return false;
+	}
+	bool encoded = edits[0] == 1;
+	if (encoded && !isEncoded(previous)) {
+		return false;
+	}
+	string from = encoded ? fromText(previous) : previous;
+	size_t pos = 1;
+	unsigned long long previousLength;
+	if (!tryGetCount(edits, pos, previousLength) || previousLength != from.size()) {
+		return false;
+	}
+	string to;
+	while (pos < edits.size()) {
+		unsigned long long code;
+		if (!tryGetCount(edits, pos, code)) {
+			return false;
+		}
+		unsigned long long length = code >> 1;
+		if (code & 1) {
+			unsigned long long start;
+			if (!tryGetCount(edits, pos, start) || start > from.size() || length > from.size() - start) {
+				return false;
+			}
+			to.append(from, (size_t)start, (size_t)length);
+		} else {
+			if (length > edits.size() - pos) {
+				return false;
+			}
+			to.append(edits, pos, (size_t)length);
+			pos += (size_t)length;
+		}
+	}
+	value = encoded ? toText(to) : to;
+	return true;
+}
+
+// the value made by applying delta (from toDelta()) to previous
+inline string fromDelta(const string& previous, const string& delta) {
+	string value;
+	if (!fromDelta(previous, delta, value)) {
+		cout << "  ERROR :: in BinaryCoding::fromDelta(), delta does not match the previous value.\n  Exiting." << endl;
+		exit(1);
+	}
+	return value;
+}
+
+}  // BinaryCoding
@@ -67,7 +67,8 @@ void DataMap::constructHeaderAndDataStrings(string& headerStr, string& dataStr,
 	if (keys.size() > 0) {  // if keys is not empty
 		for (int n = 0; n < int(keys.size()); n++) {
 			string i = keys[n];
-			typeOfKey = findKeyInData(i);
+			Key key = findKey(i);
+			typeOfKey = typeOf(key);
 			if (typeOfKey == NONE) {
 				cout << "  in DataMap::writeToFile() - key \"" << i << "\" can not be found in data map!\n  exiting." << endl;
 				exit(1);
@@ -76,7 +77,8 @@ void DataMap::constructHeaderAndDataStrings(string& headerStr, string& dataStr,
 			// the following code makes use of bit masks! in short, AVE,SUM,LIST,etc each use only one bit of an int.
 			// therefore if we apply that mask the the outputBehavior, we can see if that type of output is needed.
 
-			OB = outputBehavior[i];
+			auto behavior = outputBehavior.find(i);
+			OB = (behavior != outputBehavior.end()) ? behavior->second : 0;
 
 			if (typeOfKey == STRING || typeOfKey == STRINGSOLO) {
 				if (OB == NONE && typeOfKey == STRING) {
@@ -104,8 +106,8 @@ void DataMap::constructHeaderAndDataStrings(string& headerStr, string& dataStr,
 			if (OB & FIRST) { // save first (only?) element in vector with key as column name
 				headerStr = headerStr + FileManager::separator + i;
 				if (typeOfKey == BOOL || typeOfKey == BOOLSOLO) {
-					if (getBoolVector(i).size() > 0) {
-						dataStr = dataStr + FileManager::separator + to_string(getBoolVector(i)[0]);
+					if (valueCount(key) > 0) {
+						dataStr = dataStr + FileManager::separator + to_string(firstValue<bool>(key));
 					}
 					else {
 						dataStr = dataStr + '0';
@@ -113,8 +115,8 @@ void DataMap::constructHeaderAndDataStrings(string& headerStr, string& dataStr,
 					}
 				}
 				if (typeOfKey == DOUBLE || typeOfKey == DOUBLESOLO) {
-					if (getDoubleVector(i).size() > 0) {
-						dataStr = dataStr + FileManager::separator + to_string(getDoubleVector(i)[0]);
+					if (valueCount(key) > 0) {
+						dataStr = dataStr + FileManager::separator + to_string(firstValue<double>(key));
 					}
 					else {
 						dataStr = dataStr + '0';
@@ -122,8 +124,8 @@ void DataMap::constructHeaderAndDataStrings(string& headerStr, string& dataStr,
 					}
 				}
 				if (typeOfKey == INT || typeOfKey == INTSOLO) {
-					if (getIntVector(i).size() > 0) {
-						dataStr = dataStr + FileManager::separator + to_string(getIntVector(i)[0]);
+					if (valueCount(key) > 0) {
+						dataStr = dataStr + FileManager::separator + to_string(firstValue<int>(key));
 					}
 					else {
 						dataStr = dataStr + '0';
@@ -131,8 +133,8 @@ void DataMap::constructHeaderAndDataStrings(string& headerStr, string& dataStr,
 					}
 				}
 				if (typeOfKey == STRING || typeOfKey == STRINGSOLO) {
-					if (getStringVector(i).size() > 0) {
-						dataStr = dataStr + FileManager::separator + getStringVector(i)[0];
+					if (valueCount(key) > 0) {
+						dataStr = dataStr + FileManager::separator + firstValue<string>(key);
 					}
 					else {
 						dataStr = dataStr + '0';
@@ -143,15 +145,15 @@ void DataMap::constructHeaderAndDataStrings(string& headerStr, string& dataStr,
 			}
 			if (OB & AVE) { // key_AVE = ave of vector (will error if of type string!)
 				headerStr = headerStr + FileManager::separator + i + "_AVE";
-				dataStr = dataStr + FileManager::separator + to_string(getAverage(i));
+				dataStr = dataStr + FileManager::separator + to_string(getAverage(key));
 			}
 			if (OB & VAR) { // key_VAR = variance of vector (will error if of type string!)
 				headerStr = headerStr + FileManager::separator + i + "_VAR";
-				dataStr = dataStr + FileManager::separator + to_string(getVariance(i));
+				dataStr = dataStr + FileManager::separator + to_string(getVariance(key));
 			}
 			if (OB & SUM) { // key_SUM = sum of vector
 				headerStr = headerStr + FileManager::separator + i + "_SUM";
-				dataStr = dataStr + FileManager::separator + to_string(getSum(i));
+				dataStr = dataStr + FileManager::separator + to_string(getSum(key));
 			}
 			if (OB & PROD) { // key_PROD = product of vector
 				cout << "  WARNING OUTPUT METHOD PROD IS HAS YET TO BE WRITTEN!" << endl;
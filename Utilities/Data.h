@@ -10,6 +10,7 @@
 
 #pragma once
 
+#include <algorithm>
 #include <cwctype>
 #include <fstream>
 #include <iostream>
@@ -55,431 +56,564 @@ public:
 	map<string, int> outputBehavior; // Defines how each element should be written to file - if element not found, LIST (write out list) is used.
 	static map<string,int> knownOutputBehaviors;
 
+	// a key name interned in the key table shared by all data maps. set, append and get with a Key do not hash or
+	// compare the key name, so code which uses a key often should get it once with getKey() and keep it.
+	class Key {
+		friend class DataMap;
+		int slot;
+		explicit Key(int _slot) : slot(_slot) {}
+	public:
+		Key() : slot(-1) {}
+		// position of this key in the key table, for code which keeps an array with an entry per key
+		int index() const { return slot; }
+	};
+
+	// return the Key for name, adding name to the key table if needed
+	static Key getKey(const string& name) {
+		auto found = keySlots().find(name);
+		if (found != keySlots().end()) {
+			return Key(found->second);
+		}
+		slotKeys().push_back(name);
+		keySlots()[name] = (int)slotKeys().size() - 1;
+		return Key((int)slotKeys().size() - 1);
+	}
+
+	static const string& keyName(Key key) {
+		return slotKeys()[key.slot];
+	}
+
 private:
 	enum dataMapType {
 		NONE = 0, BOOL = 1, DOUBLE = 2, INT = 3, STRING = 4, BOOLSOLO = 11, DOUBLESOLO = 12, INTSOLO = 13, STRINGSOLO = 14
 	}; // NONE = not found in this data map
 
-	unordered_map<string, vector<bool>> boolData;
-	unordered_map<string, vector<double>> doubleData;
-	unordered_map<string, vector<int>> intData;
-	unordered_map<string, vector<string>> stringData;
+	// the key table. keys are never removed, so a Key stays valid for the whole run
+	static unordered_map<string, int>& keySlots() {
+		static unordered_map<string, int> table;
+		return table;
+	}
+	static vector<string>& slotKeys() {
+		static vector<string> names;
+		return names;
+	}
+
+	// Key for name if name is in the key table, otherwise a Key which is not in any data map
+	static Key findKey(const string& name) {
+		auto found = keySlots().find(name);
+		return Key((found != keySlots().end()) ? found->second : -1);
+	}
 
-	map<string, dataMapType> inUse; // holds list of keys with type 1=bool, 2=double, 3=int, 4=string
+	// for each key slot used by this data map, the type of the key and where it's values are in the table for that type.
+	// a bool, double or int key with a single value (set with set()) keeps the value in the slot, so it does not allocate
+	struct Slot {
+		dataMapType type = NONE;
+		int index = -1;
+		double solo = 0;
+	};
+	vector<Slot> slots;  // indexed by Key::slot
 
-public:
+	vector<vector<bool>> boolData;
+	vector<vector<double>> doubleData;
+	vector<vector<int>> intData;
+	vector<vector<string>> stringData;
 
-	DataMap() = default;
+	// per type tables and type codes, selected by a (null) pointer to the value type
+	vector<vector<bool>>& table(bool*) { return boolData; }
+	vector<vector<double>>& table(double*) { return doubleData; }
+	vector<vector<int>>& table(int*) { return intData; }
+	vector<vector<string>>& table(string*) { return stringData; }
+	static dataMapType listType(bool*) { return BOOL; }
+	static dataMapType listType(double*) { return DOUBLE; }
+	static dataMapType listType(int*) { return INT; }
+	static dataMapType listType(string*) { return STRING; }
+	static const char* typeName(bool*) { return "bool"; }
+	static const char* typeName(double*) { return "double"; }
+	static const char* typeName(int*) { return "int"; }
+	static const char* typeName(string*) { return "string"; }
 
-	// copy constructor
-	DataMap(shared_ptr<DataMap> source) {
-		boolData = source->boolData;
-		doubleData = source->doubleData;
-		intData = source->intData;
-		stringData = source->stringData;
-		for (auto entry : source->inUse) {
-			inUse[entry.first] = entry.second;
+	// list type for a type (i.e. BOOL for BOOL and BOOLSOLO)
+	static dataMapType baseType(dataMapType t) {
+		return (dataMapType)(t % 10);
+	}
+
+	inline dataMapType typeOf(Key key) const {
+		return (key.slot >= 0 && key.slot < (int)slots.size()) ? slots[key.slot].type : NONE;
+	}
+
+	// true if values of type t are kept in the slot (see Slot)
+	static bool isInline(dataMapType t) {
+		return t == BOOLSOLO || t == DOUBLESOLO || t == INTSOLO;
+	}
+
+	// convert between values and Slot::solo. strings are never inline
+	static string fromSolo(double value, string*) { return string(); }
+	template<class T> static T fromSolo(double value, T*) { return (T)value; }
+	static double toSolo(const string& value) { return 0; }
+	template<class T> static double toSolo(const T& value) { return (double)value; }
+
+	// slot for key, growing slots if needed. slots grows to cover every key known so far, so a new data map
+	// which is filled with keys that are already in the key table only allocates slots once
+	inline Slot& slotFor(Key key) {
+		if (key.slot >= (int)slots.size()) {
+			slots.resize(max(key.slot + 1, (int)slotKeys().size()));
 		}
-		//inUse = source->inUse; // replaced with for loop.
-		outputBehavior = source->outputBehavior;
+		return slots[key.slot];
 	}
 
-	inline void setOutputBehavior(const string& key, int _outputBehavior) {
-		outputBehavior[key] = _outputBehavior;
+	// values for key, which must be of type T in this data map and not inline (use forEachValue() if it may be)
+	template<class T> vector<T>& values(Key key) {
+		return table((T*)nullptr)[slots[key.slot].index];
 	}
 
-	// find key in this data map and return type (NONE = not found)
-	inline dataMapType findKeyInData(const string& key, bool printType = false) {
-		if (printType){
-			cout << key << "is of type " << inUse[key] << endl;
+	// make key type t (a list type for T, or STRINGSOLO) and return it's values. a key which is new to this data map
+	// gets empty values, and an inline value becomes the first value in the list
+	template<class T> vector<T>& store(Key key, dataMapType t) {
+		Slot& slot = slotFor(key);
+		if (slot.index < 0) {
+			auto& typeTable = table((T*)nullptr);
+			slot.index = (int)typeTable.size();
+			typeTable.emplace_back();
 		}
-		if (inUse.find(key) != inUse.end()) {
-			return inUse[key];
-		} else {
-			return NONE;
+		vector<T>& keyValues = table((T*)nullptr)[slot.index];
+		if (isInline(slot.type)) {
+			keyValues.assign(1, fromSolo(slot.solo, (T*)nullptr));
 		}
+		slot.type = t;
+		return keyValues;
 	}
 
-	// find key in this data map and return type (NONE = not found)
-	inline bool isKeySolo(const string& key) {
-		if (inUse.find(key) != inUse.end()) {
-			return ((findKeyInData(key) == BOOLSOLO) || (findKeyInData(key) == DOUBLESOLO) || (findKeyInData(key) == INTSOLO) || (findKeyInData(key) == STRINGSOLO));
+	// call f(value) for each value of key, which must be of type T in this data map
+	template<class T, class F> void forEachValue(Key key, F f) {
+		const Slot& slot = slots[key.slot];
+		if (isInline(slot.type)) {
+			f(fromSolo(slot.solo, (T*)nullptr));
 		} else {
-			cout << "  ERROR :: in DataMap::isKeySolo, key name " << key << " is not defined in DataMap. Exiting!" << endl;
-			exit(1);
+			for (const auto& value : values<T>(key)) {
+				f((T)value);
+			}
 		}
 	}
 
-	// return a string of the type of key in this data map
-	inline string lookupDataMapTypeName(dataMapType t) {
-		if (t == NONE) {
-			return "none";
-		} else if (t == BOOL || t == BOOLSOLO) {
-			return "bool";
-		} else if (t == DOUBLE || t == DOUBLESOLO) {
-			return "double";
-		} else if (t == INT || t == INTSOLO) {
-			return "int";
-		} else if (t == STRING || t == STRINGSOLO) {
-			return "string";
-		} else {
-			cout << "  In lookupDataMapTypeName... type " << t << " is not defined. Exiting!" << endl;
-			exit(1);
+	// call f(value) with each value of a bool, double or int key as a double
+	template<class F> void forEachNumber(Key key, F f) {
+		dataMapType typeOfKey = baseType(typeOf(key));
+		if (typeOfKey == BOOL) {
+			forEachValue<bool>(key, [&](bool value) { f((double)value); });
+		} else if (typeOfKey == DOUBLE) {
+			forEachValue<double>(key, [&](double value) { f(value); });
+		} else if (typeOfKey == INT) {
+			forEachValue<int>(key, [&](int value) { f((double)value); });
 		}
 	}
 
-	// return vector of strings will all keys in this data map
-	inline vector<string> getKeys() {
-		vector<string> keys;
-		for (auto e : inUse) {
-			keys.push_back(e.first); // just push back the whole key
+	// number of values of key, which must be in this data map
+	inline size_t valueCount(Key key) {
+		const Slot& slot = slots[key.slot];
+		if (isInline(slot.type)) {
+			return 1;
 		}
-		return (keys);
+		dataMapType typeOfKey = baseType(slot.type);
+		if (typeOfKey == BOOL) {
+			return boolData[slot.index].size();
+		} else if (typeOfKey == DOUBLE) {
+			return doubleData[slot.index].size();
+		} else if (typeOfKey == INT) {
+			return intData[slot.index].size();
+		}
+		return stringData[slot.index].size();
 	}
 
-	// set functions (bool,double,int,string) that take a **single** value - either make new map entry or replace existing
-	inline void set(const string& key, const bool& value) {
-		dataMapType typeOfKey = findKeyInData(key);
-		if (typeOfKey == NONE || typeOfKey == BOOL || typeOfKey == BOOLSOLO) { // if key is unused or associates with correct type
-			boolData[key] = vector<bool>( { value });
-			inUse[key] = BOOLSOLO; // since this is set with SET, it is a single value
-		} else {
-			cout << "  ERROR :: a call to DataMap::set was called where the key was already in use with another type." << endl;
-			cout << "  function was called with : key = \"" << key << "\" value = \"" << value << "\" where value is bool." << endl;
-			cout << "  but ... key is already associated with type " << findKeyInData(key) << ". Exiting." << endl;
-			exit(1);
-		}
+	// first value of key, which must be of type T in this data map and have at least one value
+	template<class T> T firstValue(Key key) {
+		const Slot& slot = slots[key.slot];
+		return isInline(slot.type) ? fromSolo(slot.solo, (T*)nullptr) : (T)values<T>(key)[0];
 	}
-	inline void set(const string& key, const double& value) {
-		dataMapType typeOfKey = findKeyInData(key);
-		if (typeOfKey == NONE || typeOfKey == DOUBLE || typeOfKey == DOUBLESOLO) { // if key is unused or associates with correct type
-			doubleData[key] = vector<double>( { value });
-			inUse[key] = DOUBLESOLO; // since this is set with SET, it is a single value
-		} else {
-			cout << "  ERROR :: a call to DataMap::set was called where the key was already in use with another type." << endl;
-			cout << "  function was called with : key = \"" << key << "\" value = \"" << value << "\" where value is double." << endl;
-			cout << "  but ... key is already associated with type " << findKeyInData(key) << ". Exiting." << endl;
-			exit(1);
-		}
+
+	// set a single value. bool, double and int values are kept inline
+	inline void storeSolo(Key key, const string& value) {
+		store<string>(key, STRINGSOLO).assign(1, value);
 	}
-	inline void set(const string& key, const int& value) {
-		dataMapType typeOfKey = findKeyInData(key);
-		if (typeOfKey == NONE || typeOfKey == INT || typeOfKey == INTSOLO) { // if key is unused or associates with correct type
-			intData[key] = vector<int>( { value });
-			inUse[key] = INTSOLO; // since this is set with SET, it is a single value
-		} else {
-			cout << "  ERROR :: a call to DataMap::set was called where the key was already in use with another type." << endl;
-			cout << "  function was called with : key = \"" << key << "\" value = \"" << value << "\" where value is int." << endl;
-			cout << "  but ... key is already associated with type " << findKeyInData(key) << ". Exiting." << endl;
-			exit(1);
-		}
+	template<class T> void storeSolo(Key key, const T& value) {
+		Slot& slot = slotFor(key);
+		slot.type = (dataMapType)(listType((T*)nullptr) + 10);
+		slot.solo = toSolo(value);
 	}
-	inline void set(const string& key, const string& value) {
-		dataMapType typeOfKey = findKeyInData(key);
-		if (typeOfKey == NONE || typeOfKey == STRING || typeOfKey == STRINGSOLO) { // if key is unused or associates with correct type
-			stringData[key] = vector<string>( { value });
-			inUse[key] = STRINGSOLO;
+
+	template<class T> void setValue(Key key, const T& value) {
+		dataMapType typeOfKey = typeOf(key);
+		if (typeOfKey == NONE || baseType(typeOfKey) == listType((T*)nullptr)) { // if key is unused or associates with correct type
+			storeSolo(key, value); // since this is set with SET, it is a single value
 		} else {
 			cout << "  ERROR :: a call to DataMap::set was called where the key was already in use with another type." << endl;
-			cout << "  function was called with : key = \"" << key << "\" value = \"" << value << "\" where value is string." << endl;
-			cout << "  but ... key is already associated with type " << findKeyInData(key) << ". Exiting." << endl;
+			cout << "  function was called with : key = \"" << keyName(key) << "\" value = \"" << value << "\" where value is " << typeName((T*)nullptr) << "." << endl;
+			cout << "  but ... key is already associated with type " << typeOfKey << ". Exiting." << endl;
 			exit(1);
 		}
 	}
 
-	// set functions (bool,double,int,string) that take a **vector** of value - either make new map entry or replace existing
-	inline void set(const string& key, const vector<bool>& value) {
-		dataMapType typeOfKey = findKeyInData(key);
-		if (typeOfKey == NONE || typeOfKey == BOOL || typeOfKey == BOOLSOLO) { // if key is unused or associates with correct type
-			boolData[key] = value;
-			inUse[key] = BOOL;
+	// value is a const vector<T>& (copied) or a vector<T>&& (moved)
+	template<class T, class V> void setValues(Key key, V&& value) {
+		dataMapType typeOfKey = typeOf(key);
+		if (typeOfKey == NONE || baseType(typeOfKey) == listType((T*)nullptr)) { // if key is unused or associates with correct type
+			store<T>(key, listType((T*)nullptr)) = forward<V>(value);
 		} else {
 			cout << "  ERROR :: a call to DataMap::set was called where the key was already in use with another type." << endl;
-			cout << "  function was called with : key = \"" << key << "\" value is a vector of bool." << endl;
-			cout << "  but ... key is already associated with type " << findKeyInData(key) << ". Exiting." << endl;
+			cout << "  function was called with : key = \"" << keyName(key) << "\" value is a vector of " << typeName((T*)nullptr) << "." << endl;
+			cout << "  but ... key is already associated with type " << typeOfKey << ". Exiting." << endl;
 			exit(1);
 		}
 	}
-	inline void set(const string& key, const vector<double>& value) {
-		dataMapType typeOfKey = findKeyInData(key);
-		if (typeOfKey == NONE || typeOfKey == DOUBLE || typeOfKey == DOUBLESOLO) { // if key is unused or associates with correct type
-			doubleData[key] = value;
-			inUse[key] = DOUBLE;
+
+	template<class T> void appendValue(Key key, const T& value) {
+		dataMapType typeOfKey = typeOf(key);
+		if (typeOfKey == NONE || baseType(typeOfKey) == listType((T*)nullptr)) { // if key is unused start a new list, else append to list
+			store<T>(key, listType((T*)nullptr)).push_back(value);  // set the in use to be a list rather then a solo
 		} else {
-			cout << "  ERROR :: a call to DataMap::set was called where the key was already in use with another type." << endl;
-			cout << "  function was called with : key = \"" << key << "\" value is a vector of double." << endl;
-			cout << "  but ... key is already associated with type " << findKeyInData(key) << ". Exiting." << endl;
+			cout << "  In DataMap::append :: attempt to append value \"" << value << "\" of type " << typeName((T*)nullptr) << " to \"" << keyName(key) << "\" but this key is already associated with " << lookupDataMapTypeName(typeOfKey) << ".\n  exiting." << endl;
 			exit(1);
 		}
 	}
-	inline void set(const string& key, const vector<int>& value) {
-		dataMapType typeOfKey = findKeyInData(key);
-		if (typeOfKey == NONE || typeOfKey == INT || typeOfKey == INTSOLO) { // if key is unused or associates with correct type
-			intData[key] = value;
-			inUse[key] = INT;
+
+	template<class T> void appendValues(Key key, const vector<T>& value) {
+		dataMapType typeOfKey = typeOf(key);
+		if (typeOfKey == NONE || baseType(typeOfKey) == listType((T*)nullptr)) { // if key is unused start a new list, else append to list
+			vector<T>& keyValues = store<T>(key, listType((T*)nullptr)); // may have been solo - make sure it's list
+			keyValues.insert(keyValues.end(), value.begin(), value.end());
 		} else {
-			cout << "  ERROR :: a call to DataMap::set was called where the key was already in use with another type." << endl;
-			cout << "  function was called with : key = \"" << key << "\" value is a vector of int." << endl;
-			cout << "  but ... key is already associated with type " << findKeyInData(key) << ". Exiting." << endl;
+			cout << "  In DataMap::append :: attempt to append a vector of type " << typeName((T*)nullptr) << " to \"" << keyName(key) << "\" but this key is already associated with " << lookupDataMapTypeName(typeOfKey) << ".\n  exiting." << endl;
 			exit(1);
 		}
 	}
-	inline void set(const string& key, const vector<string>& value) {
-		dataMapType typeOfKey = findKeyInData(key);
-		if (typeOfKey == NONE || typeOfKey == STRING || typeOfKey == STRINGSOLO) { // if key is unused or associates with correct type
-			stringData[key] = value;
-			inUse[key] = STRING;
-		} else {
-			cout << "  ERROR :: a call to DataMap::set was called where the key was already in use with another type." << endl;
-			cout << "  function was called with : key = \"" << key << "\" value is a vector of string." << endl;
-			cout << "  but ... key is already associated with type " << findKeyInData(key) << ". Exiting." << endl;
+
+	// name is the key name (key is not in the key table if name has never been used)
+	template<class T> vector<T> getValues(Key key, const string& name, const char* caller) {
+		dataMapType typeOfKey = typeOf(key);
+		if (baseType(typeOfKey) != listType((T*)nullptr) || typeOfKey == NONE) {
+			cout << "  in DataMap::" << caller << " :: attempt to use " << caller << " with key \"" << name << "\" but this key is associated with type " << typeOfKey << "\n  exiting." << endl;
+			cout << "  (if type is NONE, then the key was not found in dataMap)" << endl;
 			exit(1);
 		}
+		if (isInline(slots[key.slot].type)) {
+			return vector<T>(1, firstValue<T>(key));
+		}
+		return values<T>(key);
 	}
 
-	// append a value to the end of vector associated with key. If key is not found, start a new vector for key
-	inline void append(const string& key, const bool& value) {
-		dataMapType typeOfKey = findKeyInData(key);
-		if (typeOfKey == NONE) { // this key is not in data map, use Set.
-			set(key, value);
-			inUse[key] = BOOL; // set the in use to be a list rather then a solo
-		} else if (typeOfKey == BOOL || typeOfKey == BOOLSOLO) { // if this key is in data map as a string, append to vector
-			boolData[key].push_back(value);
-			inUse[key] = BOOL;
-		} else {
-			cout << "  In DataMap::append :: attempt to append value \"" << value << "\" of type bool to \"" << key << "\" but this key is already associated with " << lookupDataMapTypeName(typeOfKey) << ".\n  exiting." << endl;
-			exit(1);
-		}
+	// sum of values (and number of values) of a bool, double or int key
+	inline double sumValues(Key key, size_t& count) {
+		double returnValue = 0;
+		count = 0;
+		forEachNumber(key, [&](double value) {
+			returnValue += value;
+			count++;
+		});
+		return returnValue;
 	}
-	inline void append(const string& key, const double& value) {
-		dataMapType typeOfKey = findKeyInData(key);
-		if (typeOfKey == NONE) { // this key is not in data map, use Set.
-			set(key, value);
-			inUse[key] = DOUBLE; // set the in use to be a list rather then a solo
-		} else if (typeOfKey == DOUBLE || typeOfKey == DOUBLESOLO) { // if this key is in data map as a string, append to vector
-			doubleData[key].push_back(value);
-			inUse[key] = DOUBLE;
+
+	// sum of squared differences from average of the values of a bool, double or int key
+	inline double sumSquaredDifferences(Key key, double average) {
+		double returnValue = 0;
+		forEachNumber(key, [&](double value) {
+			returnValue += (value - average)*(value - average);
+		});
+		return returnValue;
+	}
+
+	// merge() for one key of type T. otherDataMap's values for key are moved if they are not appended to values in this data map
+	template<class T> void mergeValues(DataMap& otherDataMap, Key key, bool replace) {
+		const Slot& otherSlot = otherDataMap.slots[key.slot];
+		if (replace == true) { // replaced values are always a list
+			vector<T>& keyValues = store<T>(key, listType((T*)nullptr));
+			if (isInline(otherSlot.type)) {
+				keyValues.assign(1, fromSolo(otherSlot.solo, (T*)nullptr));
+			} else {
+				keyValues = move(otherDataMap.values<T>(key));
+			}
+			return;
+		}
+		if (typeOf(key) == NONE && isInline(otherSlot.type)) { // a single value which is new to this data map stays single
+			Slot& slot = slotFor(key);
+			slot.type = otherSlot.type;
+			slot.solo = otherSlot.solo;
+			return;
+		}
+		vector<T>& keyValues = store<T>(key, listType((T*)nullptr));
+		if (isInline(otherSlot.type)) {
+			keyValues.push_back(fromSolo(otherSlot.solo, (T*)nullptr));
+		} else if (keyValues.empty()) {
+			keyValues = move(otherDataMap.values<T>(key));
 		} else {
-			cout << "  In DataMap::append :: attempt to append value \"" << value << "\" of type double to \"" << key << "\" but this key is already associated with " << lookupDataMapTypeName(typeOfKey) << ".\n  exiting." << endl;
-			exit(1);
+			vector<T>& otherValues = otherDataMap.values<T>(key);
+			keyValues.insert(keyValues.end(), otherValues.begin(), otherValues.end());
+		}
+		if (keyValues.size() == 1 && otherSlot.type > 10) { // one value appended to nothing is still a single value
+			Slot& slot = slots[key.slot];
+			slot.type = otherSlot.type;
+			if (isInline(slot.type)) {
+				slot.solo = toSolo((T)keyValues[0]);
+			}
 		}
 	}
-	inline void append(const string& key, const int& value) {
-		dataMapType typeOfKey = findKeyInData(key);
-		if (typeOfKey == NONE) { // this key is not in data map, use Set.
-			set(key, value);
-			inUse[key] = INT; // set the in use to be a list rather then a solo
-		} else if (typeOfKey == INT || typeOfKey == INTSOLO) { // if this key is in data map as a string, append to vector
-			intData[key].push_back(value);
-			inUse[key] = INT; // set the in use to be a list rather then a solo
-		} else {
-			cout << "  In DataMap::append :: attempt to append value \"" << value << "\" of type int to \"" << key << "\" but this key is already associated with " << lookupDataMapTypeName(typeOfKey) << ".\n  exiting." << endl;
-			exit(1);
+
+	// copy the values of key after the first skip values into result (as a list, or a single value if skip is 0 and key
+	// holds a single value)
+	template<class T> void copyValuesTo(DataMap& result, Key key, size_t skip) {
+		const Slot& slot = slots[key.slot];
+		if (skip == 0 && slot.type > 10) {
+			if (isInline(slot.type)) {
+				Slot& resultSlot = result.slotFor(key);
+				resultSlot.type = slot.type;
+				resultSlot.solo = slot.solo;
+			} else {
+				result.store<T>(key, slot.type) = values<T>(key);
+			}
+			return;
 		}
+		vector<T>& resultValues = result.store<T>(key, listType((T*)nullptr));
+		size_t index = 0;
+		forEachValue<T>(key, [&](const T& value) {
+			if (index++ >= skip) {
+				resultValues.push_back(value);
+			}
+		});
 	}
-	inline void append(const string& key, const string& value) {
-		dataMapType typeOfKey = findKeyInData(key);
-		if (typeOfKey == NONE) { // this key is not in data map, use Set.
-			set(key, value);
-			inUse[key] = STRING; // set the in use to be a list rather then a solo
-		} else if (typeOfKey == STRING || typeOfKey == STRINGSOLO) { // if this key is in data map as a string, append to vector
-			stringData[key].push_back(value);
-			inUse[key] = STRING; // set the in use to be a list rather then a solo
-		} else {
-			cout << "  In DataMap::append :: attempt to append value \"" << value << "\" of type string to \"" << key << "\" but this key is already associated with " << lookupDataMapTypeName(typeOfKey) << ".\n  exiting." << endl;
+
+	// exit if key can not be used by getAverage, getVariance or getSum
+	inline void checkNumeric(Key key, const string& name, const char* caller, const char* action) {
+		dataMapType typeOfKey = typeOf(key);
+		if (typeOfKey == STRING || typeOfKey == STRINGSOLO) {
+			cout << "  in DataMap::" << caller << " attempt to use with vector of type string associated key \"" << name << "\".\n  Cannot average strings!\n  Exiting." << endl;
+			exit(1);
+		} else if (typeOfKey == NONE) {
+			cout << "  in DataMap::" << caller << " attempt to get " << action << " from nonexistent key \"" << name << "\".\n  Exiting." << endl;
 			exit(1);
 		}
 	}
 
-	// append a vector of values to the end of vector associated with key. If key is not found, start a new vector for key
-	inline void append(const string& key, const vector<bool>& value) {
-		dataMapType typeOfKey = findKeyInData(key);
-		if (typeOfKey == NONE) { // this key is not in data map, use Set.
-			set(key, value);
-		} else if (typeOfKey == BOOL || typeOfKey == BOOLSOLO) { // if this key is in data map as a string, append to vector
-			boolData[key].insert(boolData[key].end(), value.begin(), value.end());
-			inUse[key] = BOOL; // may have been solo - make sure it's list
-		} else {
-			cout << "  In DataMap::append :: attempt to append a vector of type bool to \"" << key << "\" but this key is already associated with " << lookupDataMapTypeName(typeOfKey) << ".\n  exiting." << endl;
-			exit(1);
+	// getAverage() and getVariance() for key, name is used in errors
+	inline double averageValues(Key key, const string& name) {
+		checkNumeric(key, name, "getAverage", "average");
+		size_t count = 0;
+		double returnValue = sumValues(key, count);
+		if (count > 1) {
+			returnValue /= count;
+		} // else vector is  size 1, no div needed or vector is empty, returnValue will be 0
+		return returnValue;
+	}
+
+	inline double varianceOfValues(Key key, const string& name) {
+		checkNumeric(key, name, "getVariance", "value");
+		size_t count = 0;
+		double averageValue = sumValues(key, count);
+		averageValue /= count;
+		double varianceValue = sumSquaredDifferences(key, averageValue);
+		if (count > 0)
+			varianceValue /= count-1;
+		else
+			varianceValue = 0;
+		return varianceValue;
+	}
+
+public:
+
+	DataMap() = default;
+
+	// copy constructor
+	DataMap(shared_ptr<DataMap> source) {
+		slots = source->slots;
+		boolData = source->boolData;
+		doubleData = source->doubleData;
+		intData = source->intData;
+		stringData = source->stringData;
+		outputBehavior = source->outputBehavior;
+	}
+
+	inline void setOutputBehavior(const string& key, int _outputBehavior) {
+		outputBehavior[key] = _outputBehavior;
+	}
+
+	// find key in this data map and return type (NONE = not found)
+	inline dataMapType findKeyInData(Key key) {
+		return typeOf(key);
+	}
+	inline dataMapType findKeyInData(const string& key, bool printType = false) {
+		if (printType){
+			cout << key << "is of type " << typeOf(findKey(key)) << endl;
 		}
+		return typeOf(findKey(key));
 	}
-	inline void append(const string& key, const vector<double>& value) {
+
+	// find key in this data map and return type (NONE = not found)
+	inline bool isKeySolo(const string& key) {
 		dataMapType typeOfKey = findKeyInData(key);
-		if (typeOfKey == NONE) { // this key is not in data map, use Set.
-			set(key, value);
-		} else if (typeOfKey == DOUBLE) { // if this key is in data map as a string, append to vector
-			doubleData[key].insert(doubleData[key].end(), value.begin(), value.end());
-			inUse[key] = DOUBLE; // may have been solo - make sure it's list
+		if (typeOfKey != NONE) {
+			return typeOfKey > 10;
 		} else {
-			cout << "  In DataMap::append :: attempt to append a vector of type double to \"" << key << "\" but this key is already associated with " << lookupDataMapTypeName(typeOfKey) << ".\n  exiting." << endl;
+			cout << "  ERROR :: in DataMap::isKeySolo, key name " << key << " is not defined in DataMap. Exiting!" << endl;
 			exit(1);
 		}
 	}
-	inline void append(const string& key, const vector<int>& value) {
-		dataMapType typeOfKey = findKeyInData(key);
-		if (typeOfKey == NONE) { // this key is not in data map, use Set.
-			set(key, value);
-		} else if (typeOfKey == INT) { // if this key is in data map as a string, append to vector
-			intData[key].insert(intData[key].end(), value.begin(), value.end());
-			inUse[key] = INT; // may have been solo - make sure it's list
+
+	// return a string of the type of key in this data map
+	inline string lookupDataMapTypeName(dataMapType t) {
+		if (t == NONE) {
+			return "none";
+		} else if (t == BOOL || t == BOOLSOLO) {
+			return "bool";
+		} else if (t == DOUBLE || t == DOUBLESOLO) {
+			return "double";
+		} else if (t == INT || t == INTSOLO) {
+			return "int";
+		} else if (t == STRING || t == STRINGSOLO) {
+			return "string";
 		} else {
-			cout << "  In DataMap::append :: attempt to append a vector of type int to \"" << key << "\" but this key is already associated with " << lookupDataMapTypeName(typeOfKey) << ".\n  exiting." << endl;
+			cout << "  In lookupDataMapTypeName... type " << t << " is not defined. Exiting!" << endl;
 			exit(1);
 		}
 	}
-	inline void append(const string& key, const vector<string>& value) {
-		dataMapType typeOfKey = findKeyInData(key);
-		if (typeOfKey == NONE) { // this key is not in data map, use Set.
-			set(key, value);
-		} else if (typeOfKey == STRING) { // if this key is in data map as a string, append to vector
-			stringData[key].insert(stringData[key].end(), value.begin(), value.end());
-			inUse[key] = STRING; // may have been solo - make sure it's list
-		} else {
-			cout << "  In DataMap::append :: attempt to append a vector of type string to \"" << key << "\" but this key is already associated with " << lookupDataMapTypeName(typeOfKey) << ".\n  exiting." << endl;
-			exit(1);
+
+	// return vector of strings will all keys in this data map (in sorted order)
+	inline vector<string> getKeys() {
+		vector<string> keys;
+		for (int i = 0; i < (int)slots.size(); i++) {
+			if (slots[i].type != NONE) {
+				keys.push_back(slotKeys()[i]);
+			}
 		}
+		sort(keys.begin(), keys.end());
+		return (keys);
 	}
 
+	// set functions (bool,double,int,string) that take a **single** value - either make new map entry or replace existing
+	inline void set(Key key, const bool& value) { setValue(key, value); }
+	inline void set(Key key, const double& value) { setValue(key, value); }
+	inline void set(Key key, const int& value) { setValue(key, value); }
+	inline void set(Key key, const string& value) { setValue(key, value); }
+	inline void set(const string& key, const bool& value) { setValue(getKey(key), value); }
+	inline void set(const string& key, const double& value) { setValue(getKey(key), value); }
+	inline void set(const string& key, const int& value) { setValue(getKey(key), value); }
+	inline void set(const string& key, const string& value) { setValue(getKey(key), value); }
+
+	// set functions (bool,double,int,string) that take a **vector** of value - either make new map entry or replace existing
+	inline void set(Key key, const vector<bool>& value) { setValues<bool>(key, value); }
+	inline void set(Key key, const vector<double>& value) { setValues<double>(key, value); }
+	inline void set(Key key, const vector<int>& value) { setValues<int>(key, value); }
+	inline void set(Key key, const vector<string>& value) { setValues<string>(key, value); }
+	inline void set(const string& key, const vector<bool>& value) { setValues<bool>(getKey(key), value); }
+	inline void set(const string& key, const vector<double>& value) { setValues<double>(getKey(key), value); }
+	inline void set(const string& key, const vector<int>& value) { setValues<int>(getKey(key), value); }
+	inline void set(const string& key, const vector<string>& value) { setValues<string>(getKey(key), value); }
+	// the vector versions which move value into the data map (i.e. set(key, move(values)) or set(key, getList()) do not copy)
+	inline void set(Key key, vector<bool>&& value) { setValues<bool>(key, move(value)); }
+	inline void set(Key key, vector<double>&& value) { setValues<double>(key, move(value)); }
+	inline void set(Key key, vector<int>&& value) { setValues<int>(key, move(value)); }
+	inline void set(Key key, vector<string>&& value) { setValues<string>(key, move(value)); }
+	inline void set(const string& key, vector<bool>&& value) { setValues<bool>(getKey(key), move(value)); }
+	inline void set(const string& key, vector<double>&& value) { setValues<double>(getKey(key), move(value)); }
+	inline void set(const string& key, vector<int>&& value) { setValues<int>(getKey(key), move(value)); }
+	inline void set(const string& key, vector<string>&& value) { setValues<string>(getKey(key), move(value)); }
+
+	// append a value to the end of vector associated with key. If key is not found, start a new vector for key
+	inline void append(Key key, const bool& value) { appendValue(key, value); }
+	inline void append(Key key, const double& value) { appendValue(key, value); }
+	inline void append(Key key, const int& value) { appendValue(key, value); }
+	inline void append(Key key, const string& value) { appendValue(key, value); }
+	inline void append(const string& key, const bool& value) { appendValue(getKey(key), value); }
+	inline void append(const string& key, const double& value) { appendValue(getKey(key), value); }
+	inline void append(const string& key, const int& value) { appendValue(getKey(key), value); }
+	inline void append(const string& key, const string& value) { appendValue(getKey(key), value); }
+
+	// append a vector of values to the end of vector associated with key. If key is not found, start a new vector for key
+	inline void append(Key key, const vector<bool>& value) { appendValues(key, value); }
+	inline void append(Key key, const vector<double>& value) { appendValues(key, value); }
+	inline void append(Key key, const vector<int>& value) { appendValues(key, value); }
+	inline void append(Key key, const vector<string>& value) { appendValues(key, value); }
+	inline void append(const string& key, const vector<bool>& value) { appendValues(getKey(key), value); }
+	inline void append(const string& key, const vector<double>& value) { appendValues(getKey(key), value); }
+	inline void append(const string& key, const vector<int>& value) { appendValues(getKey(key), value); }
+	inline void append(const string& key, const vector<string>& value) { appendValues(getKey(key), value); }
+
 	// merge contents of two data maps - if common keys are found, replace 1 = overwrite, replace 0 = append
+	// values are moved out of otherDataMap, so merging a temporary (i.e. merge(genome->getStats(prefix))) does not copy them
 	inline void merge(DataMap otherDataMap, bool replace = 0) {
-		if (replace == true) {
-			for (string key : otherDataMap.getKeys()) {
-				dataMapType typeOfKey = findKeyInData(key);
-				dataMapType typeOfOtherKey = otherDataMap.findKeyInData(key);
-				if (typeOfOtherKey == typeOfKey || typeOfKey == NONE) {
-					if (typeOfOtherKey == BOOL || typeOfOtherKey == BOOLSOLO) {
-						set(key, otherDataMap.getBoolVector(key));
-						outputBehavior[key] = otherDataMap.outputBehavior[key];
-					}
-					if (typeOfOtherKey == DOUBLE || typeOfOtherKey == DOUBLESOLO) {
-						set(key, otherDataMap.getDoubleVector(key));
-						outputBehavior[key] = otherDataMap.outputBehavior[key];
-					}
-					if (typeOfOtherKey == INT || typeOfOtherKey == INTSOLO) {
-						set(key, otherDataMap.getIntVector(key));
-						outputBehavior[key] = otherDataMap.outputBehavior[key];
-					}
-					if (typeOfOtherKey == STRING || typeOfOtherKey == STRINGSOLO) {
-						set(key, otherDataMap.getStringVector(key));
-						outputBehavior[key] = otherDataMap.outputBehavior[key];
-					}
-				} else {
-					cout << "  In DataMap::merge() - attempt to merge key: \"" << key << "\" but types do not match!\n  Exiting." << endl;
-				}
+		for (int i = 0; i < (int)otherDataMap.slots.size(); i++) {
+			Key key(i);
+			dataMapType typeOfOtherKey = otherDataMap.slots[i].type;
+			if (typeOfOtherKey == NONE) {
+				continue;
 			}
-		} else { // replace != true
-			for (string key : otherDataMap.getKeys()) {
-				dataMapType typeOfKey = findKeyInData(key);
-				dataMapType typeOfOtherKey = otherDataMap.findKeyInData(key);
-				if (typeOfOtherKey == typeOfKey || typeOfKey == NONE) {
-					if (typeOfOtherKey == BOOL || typeOfOtherKey == BOOLSOLO) {
-						append(key, otherDataMap.getBoolVector(key));
-						if (boolData[key].size() == 1 && typeOfOtherKey == BOOLSOLO) {
-							inUse[key] = BOOLSOLO;
-						} else {
-							inUse[key] = BOOL;
-						}
-						outputBehavior[key] = outputBehavior[key] | otherDataMap.outputBehavior[key];
-					}
-					if (typeOfOtherKey == DOUBLE || typeOfOtherKey == DOUBLESOLO) {
-						append(key, otherDataMap.getDoubleVector(key));
-						if (doubleData[key].size() == 1 && typeOfOtherKey == DOUBLESOLO) {
-							inUse[key] = DOUBLESOLO;
-						} else {
-							inUse[key] = DOUBLE;
-						}
-						outputBehavior[key] = outputBehavior[key] | otherDataMap.outputBehavior[key];
-					}
-					if (typeOfOtherKey == INT || typeOfOtherKey == INTSOLO) {
-						append(key, otherDataMap.getIntVector(key));
-						if (intData[key].size() == 1 && typeOfOtherKey == INTSOLO) {
-							inUse[key] = INTSOLO;
-						} else {
-							inUse[key] = INT;
-						}
-						outputBehavior[key] = outputBehavior[key] | otherDataMap.outputBehavior[key];
-					}
-					if (typeOfOtherKey == STRING || typeOfOtherKey == STRINGSOLO) {
-						append(key, otherDataMap.getStringVector(key));
-						if (stringData[key].size() == 1 && typeOfOtherKey == STRINGSOLO) {
-							inUse[key] = STRINGSOLO;
-						} else {
-							inUse[key] = STRING;
-						}
-						outputBehavior[key] = outputBehavior[key] | otherDataMap.outputBehavior[key];
+			const string& name = keyName(key);
+			dataMapType typeOfKey = typeOf(key);
+			if (baseType(typeOfOtherKey) == baseType(typeOfKey) || typeOfKey == NONE) { // a single value and a list of the same type can be merged
+				dataMapType otherBase = baseType(typeOfOtherKey);
+				if (otherBase == BOOL) {
+					mergeValues<bool>(otherDataMap, key, replace);
+				} else if (otherBase == DOUBLE) {
+					mergeValues<double>(otherDataMap, key, replace);
+				} else if (otherBase == INT) {
+					mergeValues<int>(otherDataMap, key, replace);
+				} else if (otherBase == STRING) {
+					mergeValues<string>(otherDataMap, key, replace);
+				}
+				// a key with no output behavior uses the default, so only keys which have one in either map need an entry
+				auto otherBehavior = otherDataMap.outputBehavior.find(name);
+				if (replace == true) {
+					if (otherBehavior != otherDataMap.outputBehavior.end()) {
+						outputBehavior[name] = otherBehavior->second;
+					} else {
+						outputBehavior.erase(name);
 					}
-				} else {
-					cout << "  In DataMap::merge() - attempt to merge key: \"" << key << "\" but types do not match!\n  Exiting." << endl;
+				} else if (otherBehavior != otherDataMap.outputBehavior.end()) {
+					outputBehavior[name] |= otherBehavior->second;
 				}
+			} else {
+				cout << "  In DataMap::merge() - attempt to merge key: \"" << name << "\" but types do not match!\n  Exiting." << endl;
 			}
 		}
 	}
 
-	inline vector<bool> getBoolVector(const string &key) { // retrieve a double from a dataMap with "key"
-		dataMapType typeOfKey = findKeyInData(key);
-		if (typeOfKey == BOOL || typeOfKey == BOOLSOLO) {
-			return boolData[key];
-		} else {
-			cout << "  in DataMap::getBoolVector :: attempt to use getBoolVector with key \"" << key << "\" but this key is associated with type " << typeOfKey << "\n  exiting." << endl;
-			cout << "  (if type is NONE, then the key was not found in dataMap)" << endl;
-			exit(1);
-		}
+	inline vector<bool> getBoolVector(Key key) { // retrieve a bool vector from a dataMap with "key"
+		return getValues<bool>(key, keyName(key), "getBoolVector");
 	}
-	inline vector<double> getDoubleVector(const string &key) { // retrieve a double from a dataMap with "key"
-		dataMapType typeOfKey = findKeyInData(key);
-		if (typeOfKey == DOUBLE || typeOfKey == DOUBLESOLO) {
-			return doubleData[key];
-		} else {
-			cout << "  in DataMap::getDoubleVector :: attempt to use getDoubleVector with key \"" << key << "\" but this key is associated with type " << typeOfKey << "\n  exiting." << endl;
-			cout << "  (if type is NONE, then the key was not found in dataMap)" << endl;
-			exit(1);
-		}
+	inline vector<double> getDoubleVector(Key key) { // retrieve a double vector from a dataMap with "key"
+		return getValues<double>(key, keyName(key), "getDoubleVector");
 	}
-	inline vector<int> getIntVector(const string &key) { // retrieve a double from a dataMap with "key"
-		dataMapType typeOfKey = findKeyInData(key);
-		if (typeOfKey == INT || typeOfKey == INTSOLO) {
-			return intData[key];
-		} else {
-			cout << "  in DataMap::getIntVector :: attempt to use getIntVector with key \"" << key << "\" but this key is associated with type " << typeOfKey << "\n  exiting." << endl;
-			cout << "  (if type is NONE, then the key was not found in dataMap)" << endl;
-			exit(1);
-		}
+	inline vector<int> getIntVector(Key key) { // retrieve an int vector from a dataMap with "key"
+		return getValues<int>(key, keyName(key), "getIntVector");
 	}
-	inline vector<string> getStringVector(const string &key) { // retrieve a double from a dataMap with "key"
-		dataMapType typeOfKey = findKeyInData(key);
-		if (typeOfKey == STRING || typeOfKey == STRINGSOLO) {
-			return stringData[key];
-		} else {
-			cout << "  in DataMap::getStringVector :: attempt to use getStringVector with key \"" << key << "\" but this key is associated with type " << typeOfKey << "\n  exiting." << endl;
-			cout << "  (if type is NONE, then the key was not found in dataMap)" << endl;
-			exit(1);
-		}
+	inline vector<string> getStringVector(Key key) { // retrieve a string vector from a dataMap with "key"
+		return getValues<string>(key, keyName(key), "getStringVector");
+	}
+	inline vector<bool> getBoolVector(const string &key) {
+		return getValues<bool>(findKey(key), key, "getBoolVector");
+	}
+	inline vector<double> getDoubleVector(const string &key) {
+		return getValues<double>(findKey(key), key, "getDoubleVector");
+	}
+	inline vector<int> getIntVector(const string &key) {
+		return getValues<int>(findKey(key), key, "getIntVector");
+	}
+	inline vector<string> getStringVector(const string &key) {
+		return getValues<string>(findKey(key), key, "getStringVector");
 	}
 
 	inline string getStringOfVector(const string &key) { // retrieve a string from a dataMap with "key" - if not already string, will be converted
 		string returnString = "\"[";
-		dataMapType typeOfKey = findKeyInData(key);
+		Key k = findKey(key);
+		dataMapType typeOfKey = baseType(typeOf(k));
 		if (typeOfKey == NONE) {
 			cout << "  In DataMap::GetString() :: key \"" << key << "\" is not in data map!\n  exiting." << endl;
 			exit(1);
 		} else {
-			if (typeOfKey == BOOL || typeOfKey == BOOLSOLO) {
-				for (auto e : boolData[key]) {
-					returnString += to_string(e) + ",";
-				}
-			} else if (typeOfKey == DOUBLE || typeOfKey == DOUBLESOLO) {
-				for (auto e : doubleData[key]) {
-					returnString += to_string(e) + ",";
-				}
-			} else if (typeOfKey == INT || typeOfKey == INTSOLO) {
-				for (auto e : intData[key]) {
-					returnString += to_string(e) + ",";
-				}
-			} else if (typeOfKey == STRING || typeOfKey == STRINGSOLO) {
-				for (auto e : stringData[key]) {
-					returnString += e + ",";
-				}
+			if (typeOfKey == BOOL) {
+				forEachValue<bool>(k, [&](bool e) { returnString += to_string(e) + ","; });
+			} else if (typeOfKey == DOUBLE) {
+				forEachValue<double>(k, [&](double e) { returnString += to_string(e) + ","; });
+			} else if (typeOfKey == INT) {
+				forEachValue<int>(k, [&](int e) { returnString += to_string(e) + ","; });
+			} else if (typeOfKey == STRING) {
+				forEachValue<string>(k, [&](const string& e) { returnString += e + ","; });
 			}
 		}
 		if (returnString.size() > 2) { // if vector was not empty
@@ -490,159 +624,104 @@ public:
 	}
 
 	// get ave of values in a vector - must be bool, double or, int
+	inline double getAverage(Key key) {
+		return averageValues(key, keyName(key));
+	}
 	inline double getAverage(string key) { // not ref, we may need to change to a "{LIST}" key
-		dataMapType typeOfKey = findKeyInData(key);
-		double returnValue = 0;
-		if (typeOfKey == BOOL || typeOfKey == BOOLSOLO) {
-			for (auto e : boolData[key]) {
-				returnValue += (double) e;
-			}
-			if (boolData[key].size() > 1) {
-				returnValue /= boolData[key].size();
-			} // else vector is  size 1, no div needed or vector is empty, returnValue will be 0
-		} else if (typeOfKey == DOUBLE || typeOfKey == DOUBLESOLO) {
-			for (auto e : doubleData[key]) {
-				returnValue += (double) e;
-			}
-			if (doubleData[key].size() > 1) {
-				returnValue /= doubleData[key].size();
-			} // else vector is  size 1, no div needed or vector is empty, returnValue will be 0
-		} else if (typeOfKey == INT || typeOfKey == INTSOLO) {
-			for (auto e : intData[key]) {
-				returnValue += (double) e;
-			}
-			if (intData[key].size() > 1) {
-				returnValue /= intData[key].size();
-			} // else vector is  size 1, no div needed or vector is empty, returnValue will be 0
-		} else if (typeOfKey == STRING || typeOfKey == STRINGSOLO) {
-			cout << "  in DataMap::getAverage attempt to use with vector of type string associated key \"" << key << "\".\n  Cannot average strings!\n  Exiting." << endl;
-			exit(1);
-		} else if (typeOfKey == NONE) {
-			cout << "  in DataMap::getAverage attempt to get average from nonexistent key \"" << key << "\".\n  Exiting." << endl;
-			exit(1);
-		}
-		return returnValue;
+		return averageValues(findKey(key), key);
 	}
 
+	inline double getVariance(Key key) {
+		return varianceOfValues(key, keyName(key));
+	}
 	inline double getVariance(string key) { // not ref, we may need to change to a "{LIST}" key
-		dataMapType typeOfKey = findKeyInData(key);
-		double averageValue(0);
-		double varianceValue(0);
-		if (typeOfKey == BOOL || typeOfKey == BOOLSOLO) {
-			for (auto e : boolData[key]) {
-				averageValue += (double) e;
-			}
-			averageValue /= boolData[key].size();
-			for (auto e : boolData[key]) {
-				varianceValue += ((double) e - averageValue)*((double) e - averageValue);
-			}
-			if (boolData[key].size() > 0)
-				varianceValue /= boolData[key].size()-1;
-			else
-				varianceValue = 0;
-		} else if (typeOfKey == DOUBLE || typeOfKey == DOUBLESOLO) {
-			for (auto e : doubleData[key]) {
-				averageValue += (double) e;
-			}
-			averageValue /= doubleData[key].size();
-			for (auto e : doubleData[key]) {
-				varianceValue += ((double) e - averageValue)*((double) e - averageValue);
-			}
-			if (doubleData[key].size() > 0)
-				varianceValue /= doubleData[key].size()-1;
-			else
-				varianceValue = 0;
-		} else if (typeOfKey == INT || typeOfKey == INTSOLO) {
-			for (auto e : intData[key]) {
-				averageValue += (double) e;
-			}
-			averageValue /= intData[key].size();
-			for (auto e : intData[key]) {
-				varianceValue += ((double) e - averageValue)*((double) e - averageValue);
-			}
-			if (intData[key].size() > 0)
-				varianceValue /= intData[key].size()-1;
-			else
-				varianceValue = 0;
-		} else if (typeOfKey == STRING || typeOfKey == STRINGSOLO) {
-			cout << "  in DataMap::getVariance attempt to use with vector of type string associated key \"" << key << "\".\n  Cannot average strings!\n  Exiting." << endl;
-			exit(1);
-		} else if (typeOfKey == NONE) {
-			cout << "  in DataMap::getVariance attempt to get value from nonexistent key \"" << key << "\".\n  Exiting." << endl;
-			exit(1);
-		}
-		return varianceValue;
+		return varianceOfValues(findKey(key), key);
 	}
 
-	// get ave of values in a vector - must be bool, double or, int
+	// get sum of values in a vector - must be bool, double or, int
+	inline double getSum(Key key) {
+		checkNumeric(key, keyName(key), "getAverage", "average");
+		size_t count = 0;
+		return sumValues(key, count);
+	}
 	inline double getSum(string key) { // not ref, we may need to change to a "{LIST}" key
-		dataMapType typeOfKey = findKeyInData(key);
-		double returnValue = 0;
-		if (typeOfKey == BOOL || typeOfKey == BOOLSOLO) {
-			for (auto e : boolData[key]) {
-				returnValue += (double)e;
-			}
-			//if (boolData[key].size() > 1) {
-			//	returnValue /= boolData[key].size();
-			//} // else vector is  size 1, no div needed or vector is empty, returnValue will be 0
-		}
-		else if (typeOfKey == DOUBLE || typeOfKey == DOUBLESOLO) {
-			for (auto e : doubleData[key]) {
-				returnValue += (double)e;
-			}
-			//if (doubleData[key].size() > 1) {
-			//	returnValue /= doubleData[key].size();
-			//} // else vector is  size 1, no div needed or vector is empty, returnValue will be 0
-		}
-		else if (typeOfKey == INT || typeOfKey == INTSOLO) {
-			for (auto e : intData[key]) {
-				returnValue += (double)e;
-			}
-			//if (intData[key].size() > 1) {
-			//	returnValue /= intData[key].size();
-			//} // else vector is  size 1, no div needed or vector is empty, returnValue will be 0
-		}
-		else if (typeOfKey == STRING || typeOfKey == STRINGSOLO) {
-			cout << "  in DataMap::getAverage attempt to use with vector of type string associated key \"" << key << "\".\n  Cannot average strings!\n  Exiting." << endl;
-			exit(1);
-		}
-		else if (typeOfKey == NONE) {
-			cout << "  in DataMap::getAverage attempt to get average from nonexistent key \"" << key << "\".\n  Exiting." << endl;
-			exit(1);
-		}
-		return returnValue;
+		Key k = findKey(key);
+		checkNumeric(k, key, "getAverage", "average");
+		size_t count = 0;
+		return sumValues(k, count);
 	}
 
 	// Clear a field in a DataMap
 	inline void clear(const string &key) {
-		dataMapType typeOfKey = findKeyInData(key);
-		if (typeOfKey != NONE) {
-			if (typeOfKey == BOOL || typeOfKey == BOOLSOLO) { // data is bool
-				boolData.erase(key);
-			} else if (typeOfKey == DOUBLE || typeOfKey == DOUBLESOLO) { // data is double
-				doubleData.erase(key);
-			} else if (typeOfKey == INT || typeOfKey == INTSOLO) { // data is int
-				intData.erase(key);
-			} else if (typeOfKey == STRING || typeOfKey == STRINGSOLO) { // data is string
-				stringData.erase(key);
+		Key k = findKey(key);
+		dataMapType typeOfKey = baseType(typeOf(k));
+		if (typeOfKey != NONE && isInline(slots[k.slot].type)) {
+			slots[k.slot] = Slot();
+		} else if (typeOfKey != NONE) {
+			if (typeOfKey == BOOL) { // data is bool
+				vector<bool>().swap(values<bool>(k));
+			} else if (typeOfKey == DOUBLE) { // data is double
+				vector<double>().swap(values<double>(k));
+			} else if (typeOfKey == INT) { // data is int
+				vector<int>().swap(values<int>(k));
+			} else if (typeOfKey == STRING) { // data is string
+				vector<string>().swap(values<string>(k));
 			}
-			inUse.erase(key);
+			slots[k.slot] = Slot();  // the (now empty) values are not reused
 		}
 	}
 
 	// Clear all data in a DataMap
 	inline void clearMap() {
+		slots.clear();
 		boolData.clear();
 		doubleData.clear();
 		intData.clear();
 		stringData.clear();
-		inUse.clear();
 	}
 
-	inline bool fieldExists(const string &key) {  // return true if a data map contains "key"
+	// make this an empty data map (like a new DataMap) but keep the memory used for slots, so that a data map which is
+	// reused (see OrganismPool) does not allocate again for keys it has held before
+	inline void reset() {
+		slots.assign(slots.size(), Slot());
+		boolData.clear();
+		doubleData.clear();
+		intData.clear();
+		stringData.clear();
+		outputBehavior.clear();
+	}
+
+	inline bool fieldExists(Key key) {  // return true if a data map contains "key"
+		return (typeOf(key) > 0);
+	}
+	inline bool fieldExists(const string &key) {
 		return (findKeyInData(key) > 0);
 	}
 
+	// number of values of key, 0 if key is not in this data map
+	inline size_t getValueCount(const string &key) {
+		Key k = findKey(key);
+		return (typeOf(k) == NONE) ? 0 : valueCount(k);
+	}
+
+	// a data map with only key, holding the values of key in this data map after the first skip values. merging
+	// the result into a data map (with skip = the number of values before some were appended) repeats the append
+	inline DataMap copyKey(const string &key, size_t skip = 0) {
+		DataMap result;
+		Key k = findKey(key);
+		dataMapType typeOfKey = baseType(typeOf(k));
+		if (typeOfKey == BOOL) {
+			copyValuesTo<bool>(result, k, skip);
+		} else if (typeOfKey == DOUBLE) {
+			copyValuesTo<double>(result, k, skip);
+		} else if (typeOfKey == INT) {
+			copyValuesTo<int>(result, k, skip);
+		} else if (typeOfKey == STRING) {
+			copyValuesTo<string>(result, k, skip);
+		}
+		return result;
+	}
+
 	// take two strings (header and data), and a list of keys, and whether or not to save "{LIST}"s. convert data from data map to header and data strings
 	void constructHeaderAndDataStrings(string& headerStr, string& dataStr, const vector<string>& keys, bool aveOnly = false);
 
@@ -668,18 +747,18 @@ public:
 	inline vector<string> getColumnNames(){
 		vector<string> columnNames;
 
-		for (auto element:inUse){
-			if (outputBehavior.find(element.first) == outputBehavior.end()){
+		for (auto key : getKeys()){
+			if (outputBehavior.find(key) == outputBehavior.end()){
 				// this element has no defined output behavior, so it will be LIST (default) or FIRST (if it's a solo value)
-				if (element.second == BOOLSOLO || element.second == DOUBLESOLO || element.second == INTSOLO || element.second == STRINGSOLO){
-					columnNames.push_back(element.first);
+				if (findKeyInData(key) > 10){
+					columnNames.push_back(key);
 				} else {
-					columnNames.push_back(element.first + "_LIST");
+					columnNames.push_back(key + "_LIST");
 				}
 			} else { // there is an output behavior defined
-				auto OB = outputBehavior[element.first];
+				auto OB = outputBehavior[key];
 				if (OB & AVE) {
-					columnNames.push_back(element.first + "_AVE");
+					columnNames.push_back(key + "_AVE");
 				}
 				if (OB & SUM) {
 					cout << "  WARNING OUTPUT METHOD SUM IS HAS YET TO BE WRITTEN!" << endl;
@@ -691,7 +770,7 @@ public:
 					cout << "  WARNING OUTPUT METHOD STDERR IS HAS YET TO BE WRITTEN!" << endl;
 				}
 				if (OB & LIST) {
-					columnNames.push_back(element.first + "_LIST");
+					columnNames.push_back(key + "_LIST");
 				}
 
 			}
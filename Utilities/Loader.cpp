@@ -15,6 +15,7 @@
 //#include <experimental/filesystem>
 #include "zupply.h" // for x-platform filesystem
 #include "Loader.h"
+#include "BinaryCoding.h"
 
 using std::cout;
 using std::endl;
@@ -535,15 +536,30 @@ Loader::get_attribute_map(const std::string &file_name) {
   }
   
   // checking for MABE csv-ness
-  std::regex mabe_csv_regex(R"((([-\.\d]+)(?:,|$))|("\[)|(([-\.\d]+\]")(?:,|$)))");
+  // values are numbers, quoted lists or #index tokens standing in for encoded or delta data (see below)
+  std::regex mabe_csv_regex(R"((([-\.\d]+)(?:,|$))|("\[)|(([-\.\d]+\]")(?:,|$))|((#\d+)(?:,|$)))");
   //	std::regex mabe_csv_regex(R"(("[^"]+"|[^,]+)(,|$))");  // does not work because of 
   //	https://gcc.gnu.org/bugzilla/show_bug.cgi?id=61582
   std::string org_details;
+  // delta values (see BinaryCoding.h) are edits to the same attribute on the line before
+  std::map<std::string, std::string> previous_values;
   while (getline(file, org_details)) {
     std::map<std::string, std::string> temp_result;
     long k = 0;
     auto in_quotes = false;
     std::string quote_str = "";
+    // encoded and delta data (see BinaryCoding.h) can be too long to match with std::regex, so each
+    // such value is replaced with a short #index token before matching
+    std::vector<std::string> encoded_values;
+    for (auto start = org_details.find_first_of("#~"); start != std::string::npos;
+         start = org_details.find_first_of("#~", start + 1)) {
+      auto end = org_details.find(',', start);
+      if (end == std::string::npos)
+        end = org_details.size();
+      encoded_values.push_back(org_details.substr(start, end - start));
+      org_details.replace(start, end - start,
+                          "#" + std::to_string(encoded_values.size() - 1));
+    }
     for (std::sregex_iterator end,
          i = std::sregex_iterator(org_details.begin(), org_details.end(),
                                   mabe_csv_regex);
@@ -563,10 +579,38 @@ Loader::get_attribute_map(const std::string &file_name) {
         temp_result[attribute_names.at(k++)] = quote_str;
         in_quotes = false;
         quote_str = "";
+      } else if (m[6].length()) {
+        temp_result[attribute_names.at(k++)] =
+            encoded_values.at(std::stol(m[7].str().substr(1)));
       } else {
         cout << " error : something wrong with mabe csv-ness " << endl;
         exit(1);
       }
+    }
+    for (auto &attribute : temp_result) {
+      if (BinaryCoding::isDelta(attribute.second)) {
+        auto previous = previous_values.find(attribute.first);
+        if (previous == previous_values.end()) {
+          cout << " error: " << attribute.first << " for organism with ID "
+               << temp_result["ID"] << " in file " << file_name
+               << " is a delta, but no earlier line (keyframe) has a value for "
+                  "it. Was the file truncated or edited?"
+               << endl;
+          exit(1);
+        }
+        std::string value;
+        if (!BinaryCoding::fromDelta(previous->second, attribute.second,
+                                     value)) {
+          cout << " error: " << attribute.first << " for organism with ID "
+               << temp_result["ID"] << " in file " << file_name
+               << " is a delta which does not match the value on the line "
+                  "before it. Was the file truncated or edited?"
+               << endl;
+          exit(1);
+        }
+        attribute.second = value;
+      }
+      previous_values[attribute.first] = attribute.second;
     }
 	auto orig_ID = std::stol(temp_result.at("ID"));
 	temp_result.erase("ID");
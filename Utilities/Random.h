@@ -65,6 +65,26 @@ inline int getBinomial(const int tests, const double probability, Generator& gen
 	return binomial_distribution<>(tests, probability)(gen);
 }
 
+// Calls visit(index), in increasing order, for each index in [0, count) which passes a trial with
+// "probability" of success. The gaps between successes are drawn from a geometric distribution,
+// so the cost is proportional to the number of successes rather than to count.
+template<class Function>
+inline void forEachSuccess(const int count, const double probability, Function visit, Generator& gen = getCommonGenerator()) {
+	if (probability <= 0) {
+		return;
+	}
+	if (probability >= 1) {
+		for (int index = 0; index < count; index++) {
+			visit(index);
+		}
+		return;
+	}
+	geometric_distribution<long long> skip(probability);
+	for (long long index = skip(gen); index < count; index += skip(gen) + 1) {
+		visit((int)index);
+	}
+}
+
 // Returns true with "probability" probability
 inline bool P(const double probability, Generator& gen = getCommonGenerator()) {
 	return bernoulli_distribution(probability)(gen);
@@ -15,8 +15,51 @@
 #include "../Utilities/Data.h"
 #include "../Utilities/MTree.h"
 
+shared_ptr<ParameterLink<bool>> AbstractWorld::cacheEvaluationsPL = Parameters::register_parameter("WORLD-cacheEvaluations", false, "if true, organisms which survive or are copied (elitism) get the score from their last evaluation and are not evaluated again (only in worlds which support this, and only for organisms with deterministic brains)");
 shared_ptr<ParameterLink<bool>> AbstractWorld::debugPL = Parameters::register_parameter("WORLD-debug", false, "run world in debug mode (if available)");
 
 ////// WORLD-worldType is actually set by Modules.h //////
 shared_ptr<ParameterLink<string>> AbstractWorld::worldTypePL = Parameters::register_parameter("WORLD-worldType", (string) "This_string_is_set_by_modules.h", "This_string_is_set_by_modules.h");
 ////// WORLD-worldType is actually set by Modules.h //////
+
+void AbstractWorld::evaluateSoloCached(shared_ptr<Group> group, int index, int analyze, int visualize, int debug) {
+	auto org = group->population[index];
+	soloStats = group->populationStats;
+	soloIndex = index;
+	if (!cacheEvaluationsPL->get(PT) || evaluationCacheKeys.empty() || analyze || visualize || debug) {
+		evaluateSolo(org, analyze, visualize, debug);
+		soloStats = nullptr;
+		return;
+	}
+	if (org->evaluationCache) { // repeat what the last evaluation did to dataMap
+		for (auto& key : org->evaluationCache->replacedKeys) {
+			org->dataMap.clear(key);
+		}
+		org->dataMap.merge(org->evaluationCache->values); // not written to soloStats, so read from dataMap when archived
+		soloStats = nullptr;
+		return;
+	}
+	vector<size_t> counts;  // number of values of each key before evaluation
+	for (auto& key : evaluationCacheKeys) {
+		counts.push_back(org->dataMap.getValueCount(key));
+	}
+	evaluateSolo(org, analyze, visualize, debug);
+	soloStats = nullptr;
+	for (auto& brain : org->brains) {
+		if (!brain.second->isDeterministic()) {
+			return;
+		}
+	}
+	// a list with more values was appended to (the new values are kept), otherwise the key was set (all of it's values are kept)
+	auto cache = make_shared<Organism::EvaluationCache>();
+	for (size_t i = 0; i < evaluationCacheKeys.size(); i++) {
+		const string& key = evaluationCacheKeys[i];
+		if (org->dataMap.getValueCount(key) > counts[i] && !org->dataMap.isKeySolo(key)) {
+			cache->values.merge(org->dataMap.copyKey(key, counts[i]));
+		} else {
+			cache->replacedKeys.push_back(key);
+			cache->values.merge(org->dataMap.copyKey(key));
+		}
+	}
+	org->evaluationCache = cache;
+}
@@ -25,6 +25,7 @@ class AbstractWorld {
 public:
 	static shared_ptr<ParameterLink<bool>> debugPL;
 	static shared_ptr<ParameterLink<string>> worldTypePL;
+	static shared_ptr<ParameterLink<bool>> cacheEvaluationsPL;
 	
 	const shared_ptr<ParametersTable> PT;
 
@@ -33,6 +34,10 @@ public:
 
 	vector<string> popFileColumns;
 
+	// keys which evaluateSolo() sets or appends to in an organisms dataMap, if the values only depend on the organism
+	// (when it's brains are deterministic). a world which lists keys here can use evaluateSoloCached()
+	vector<string> evaluationCacheKeys;
+
 	AbstractWorld(shared_ptr<ParametersTable> _PT) :
 			PT(_PT) {
 	}
@@ -52,4 +57,30 @@ public:
 		cout << "  chosen world does not define evaluateSolo()! Exiting." << endl;
 		exit(1);
 	};
+
+	// evaluateSolo() for group->population[index], but if WORLD-cacheEvaluations is set, an organism which has been
+	// evaluated before (or is a copy of one) gets the values of evaluationCacheKeys from it's last evaluation and is not
+	// evaluated again. values evaluateSolo() writes with setValue() and appendValue() also go to the groups PopulationStats
+	void evaluateSoloCached(shared_ptr<Group> group, int index, int analyze, int visualize, int debug);
+
+protected:
+	// PopulationStats and population index of the organism evaluateSoloCached() is evaluating (nullptr if none)
+	shared_ptr<PopulationStats> soloStats = nullptr;
+	int soloIndex = -1;
+
+	// set or append to key in org's dataMap, and if org is being evaluated by evaluateSoloCached() in it's groups PopulationStats
+	template<class T> void setValue(shared_ptr<Organism> org, DataMap::Key key, const T& value) {
+		if (soloStats) {
+			soloStats->set(soloIndex, org->dataMap, key, value);
+		} else {
+			org->dataMap.set(key, value);
+		}
+	}
+	template<class T> void appendValue(shared_ptr<Organism> org, DataMap::Key key, const T& value) {
+		if (soloStats) {
+			soloStats->append(soloIndex, org->dataMap, key, value);
+		} else {
+			org->dataMap.append(key, value);
+		}
+	}
 };
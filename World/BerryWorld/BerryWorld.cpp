@@ -752,12 +752,18 @@ void BerryWorld::evaluate(map<string, shared_ptr<Group>>& groups, int analyse, i
 }
 
 void BerryWorld::runWorld(map<string, shared_ptr<Group>>& groups, int analyse, int visualize, int debug) {
-	auto tempPopulation = groups[groupNameSpacePL->get(PT)]->population; // make a copy of the population so we can pull unique organisms when making evaluation groups
+	auto group = groups[groupNameSpacePL->get(PT)];
+	auto& population = group->population;
+	vector<int> allIndices(population.size()); // index of each organism in population
+	for (int i = 0; i < (int)allIndices.size(); i++) {
+		allIndices[i] = i;
+	}
+	auto tempPopulation = allIndices; // make a copy of the indices so we can pull unique organisms when making evaluation groups
 	auto populationSize = tempPopulation.size();
 	auto groupSize = evaluateGroupSizePL->get(PT);
 
 	int numberOfEvalGroups = ceil(((double)populationSize) / ((double)groupSize));
-	vector<vector<shared_ptr<Organism>>> evalGroups;
+	vector<vector<int>> evalGroups; // index in population of each organism in each eval group
 
 
 	// eval groups are generated each with evalGroupSize organisms
@@ -768,7 +774,7 @@ void BerryWorld::runWorld(map<string, shared_ptr<Group>>& groups, int analyse, i
 		exit(1);
 	}
 	for (int p = 0; p < numberOfEvalGroups; p++) { // for each eval group
-		vector<shared_ptr<Organism>> thisGroup; // create a temporary holder for this
+		vector<int> thisGroup; // create a temporary holder for this
 		if (tempPopulation.size() > groupSize) { // if there are enough organisms in tempPopulation for this group
 			for (int o = 0; o < groupSize; o++) { // pull evalGroupSize organisms
 				auto pick = Random::getIndex(tempPopulation.size()); // get a random index
@@ -779,7 +785,7 @@ void BerryWorld::runWorld(map<string, shared_ptr<Group>>& groups, int analyse, i
 		}
 		else {// tempPopulation.size() is < evalGroupSize, some orgs need to be evaluateded twice (i.e. be in more then one eval group)
 			thisGroup = tempPopulation; // place the rest of the orgs in temp population into thisGroup
-			tempPopulation = groups[groupNameSpacePL->get(PT)]->population; // refresh tempPopulation
+			tempPopulation = allIndices; // refresh tempPopulation
 			// fill in any remaining spaces randomly...
 			for (int o = thisGroup.size(); o < groupSize; o++) { // fill in the rest of thisGroup
 				auto pick = Random::getIndex(tempPopulation.size()); // get a random index
@@ -796,7 +802,7 @@ void BerryWorld::runWorld(map<string, shared_ptr<Group>>& groups, int analyse, i
 		for (int gID = 0; gID < evalGroups.size(); gID++) {
 			cout << "group " << gID << " contains: ";
 			for (auto o : evalGroups[gID]) {
-				cout << o->ID << " ";
+				cout << population[o]->ID << " ";
 			}
 			cout << endl;
 		}
@@ -952,8 +958,10 @@ void BerryWorld::runWorld(map<string, shared_ptr<Group>>& groups, int analyse, i
 			auto tempStartFacing = startFacing;
 												// for each org in this group, create a harvester and pick a location and faceing direction
 			int IDCount = 0;
-			for (auto org : evalGroup) {
+			for (auto index : evalGroup) {
+				auto org = population[index];
 				auto newHarvester = make_shared<Harvester>(); // make a new container
+				newHarvester->index = index;
 				newHarvester->ID = IDCount++;
 				newHarvester->cloneID = newHarvester->ID;
 				newHarvester->org = org; // provide access to org though harvester
@@ -993,6 +1001,7 @@ void BerryWorld::runWorld(map<string, shared_ptr<Group>>& groups, int analyse, i
 					newHarvester->ID = IDCount++;
 					newHarvester->cloneID = harvesters[i]->ID;
 					newHarvester->org = harvesters[i]->org; // provide access to org though harvester
+					newHarvester->index = harvesters[i]->index;
 					newHarvester->brain = harvesters[i]->brain->makeCopy();
 					// set inital location
 					auto pick = Random::getIndex(tempValidSpaces.size()); // get a random index
@@ -1385,7 +1394,7 @@ void BerryWorld::runWorld(map<string, shared_ptr<Group>>& groups, int analyse, i
 					harvester->totalFood += harvester->foodCollected[f];
 					harvester->foodScore += foodRewards[f] * harvester->foodCollected[f];
 					if (poisonRules[f] != 0) {
-						harvester->org->dataMap.append("poison" + to_string(f), harvester->poisonTotals[f]);
+						group->populationStats->append(harvester->index, harvester->org->dataMap, DataMap::getKey("poison" + to_string(f)), harvester->poisonTotals[f]);
 					}
 				}
 
@@ -1427,17 +1436,19 @@ void BerryWorld::runWorld(map<string, shared_ptr<Group>>& groups, int analyse, i
 
 			// now save data to dataMaps for everytone in saveHarvesters
 			for (auto harvester : saveHarvesters) {
+				auto& stats = *group->populationStats;
+				auto& dataMap = harvester->org->dataMap;
 				for (int f = 1; f <= foodTypes; f++) {
-					harvester->org->dataMap.append("food" + to_string(f), harvester->foodCollected[f]);
+					stats.append(harvester->index, dataMap, DataMap::getKey("food" + to_string(f)), harvester->foodCollected[f]);
 					if (poisonRules[f] != 0) {
-						harvester->org->dataMap.append("poison" + to_string(f), harvester->poisonTotals[f]);
+						stats.append(harvester->index, dataMap, DataMap::getKey("poison" + to_string(f)), harvester->poisonTotals[f]);
 					}
 				}
-				harvester->org->dataMap.append("switches", harvester->switches);
-				harvester->org->dataMap.append("consumptionRatio", harvester->maxFood / (harvester->totalFood - harvester->maxFood + 1));
-				harvester->org->dataMap.append("wallHits", harvester->wallHits);
-				harvester->org->dataMap.append("otherHits", harvester->otherHits);
-				harvester->org->dataMap.append("score", harvester->score);
+				stats.append(harvester->index, dataMap, DataMap::getKey("switches"), harvester->switches);
+				stats.append(harvester->index, dataMap, DataMap::getKey("consumptionRatio"), harvester->maxFood / (harvester->totalFood - harvester->maxFood + 1));
+				stats.append(harvester->index, dataMap, DataMap::getKey("wallHits"), harvester->wallHits);
+				stats.append(harvester->index, dataMap, DataMap::getKey("otherHits"), harvester->otherHits);
+				stats.append(harvester->index, dataMap, DataMap::getKey("score"), harvester->score);
 			}
 
 		} // end evaluations all evalGroups
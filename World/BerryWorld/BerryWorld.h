@@ -226,6 +226,7 @@ public:
 	class Harvester {
 	public:
 		shared_ptr<Organism> org;
+		int index; // index of org in it's groups population
 		shared_ptr<AbstractBrain> brain;
 		int ID;
 		int cloneID;
@@ -27,9 +27,13 @@ TestWorld::TestWorld(shared_ptr<ParametersTable> _PT) :
 	popFileColumns.clear();
 	popFileColumns.push_back("score");
 	popFileColumns.push_back("score_VAR"); // specifies to also record the variance (performed automatically because _VAR)
+
+	// score only depends on the brain (see evaluateSoloCached())
+	evaluationCacheKeys.push_back("score");
 }
 
 void TestWorld::evaluateSolo(shared_ptr<Organism> org, int analyze, int visualize, int debug) {
+	static const DataMap::Key scoreKey = DataMap::getKey("score");
 	auto brain = org->brains[brainNamePL->get(PT)];
 	for (int r = 0; r < evaluationsPerGenerationPL->get(PT); r++) {
 		brain->resetBrain();
@@ -41,7 +45,7 @@ void TestWorld::evaluateSolo(shared_ptr<Organism> org, int analyze, int visualiz
 			else                      score += brain->readOutput(i);
 		}
 		if (score < 0.0) score = 0.0;
-		org->dataMap.append("score", score);
+		appendValue(org, scoreKey, score);
 		if (visualize) cout << "organism with ID " << org->ID << " scored " << score << endl;
 		
 	}	
@@ -30,6 +30,9 @@ XorWorld::XorWorld(shared_ptr<ParametersTable> _PT) :AbstractWorld(_PT) {
 	popFileColumns.clear();
 	popFileColumns.push_back("score");
 	popFileColumns.push_back("score_VAR"); // specifies to also record the variance (performed automatically because _VAR)
+
+	// score only depends on the brain (see evaluateSoloCached())
+	evaluationCacheKeys.push_back("score");
 }
 
 // score 1.0 points accumulated per correct xor answer
@@ -58,5 +61,6 @@ void XorWorld::evaluateSolo(shared_ptr<Organism> org, int analyze, int visualize
 			score+=1.0-((answers[bitBattern]-answer)*(answers[bitBattern]-answer)); // add 1.0 for a correct answer
 		}
 	}
-	org->dataMap.set("score",score/evaluationsPerGenerationPL->get(PT));
+	static const DataMap::Key scoreKey = DataMap::getKey("score");
+	setValue(org, scoreKey, score/evaluationsPerGenerationPL->get(PT));
 }
@@ -33,9 +33,10 @@ public:
 	virtual ~XorWorld() = default;
 	virtual void evaluateSolo(shared_ptr<Organism> org, int analyze, int visualize, int debug) override;
 	virtual void evaluate(map<string, shared_ptr<Group>>& groups, int analyze, int visualize, int debug) {
-		int popSize = groups[groupNamePL->get(PT)]->population.size();
+		auto group = groups[groupNamePL->get(PT)];
+		int popSize = group->population.size();
 		for (int i = 0; i < popSize; i++) {
-			evaluateSolo(groups[groupNamePL->get(PT)]->population[i], analyze, visualize, debug);
+			evaluateSoloCached(group, i, analyze, visualize, debug);
 		}
 	}
 
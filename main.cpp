@@ -22,6 +22,9 @@
 #include "Group/Group.h"
 
 #include "Organism/Organism.h"
+#include "Organism/OrganismPool.h"
+
+#include "Brain/CachedBrain.h"
 
 #include "Utilities/Parameters.h"
 #include "Utilities/Random.h"
@@ -112,6 +115,8 @@ int main(int argc, const char *argv[]) {
     cout << "Using Random Seed: " << Global::randomSeedPL->get() << endl;
   }
 
+  OrganismPool::setLimit(max(0, Global::organismPoolSizePL->get()));
+
   // make world uses WORLD-worldType to determine type of world
   auto world = makeWorld(Parameters::root);
   map<string, shared_ptr<Group>> groups;
@@ -208,6 +213,19 @@ int main(int argc, const char *argv[]) {
            << " brain using " << brainName << " name space." << endl;
       templateBrains[brainName] =
           makeTemplateBrain(brainIns[brainName], brainOuts[brainName], This_PT);
+      if (CachedBrain::useCachePL->get(This_PT)) {
+        cout << "    ..... results of deterministic updates will be cached"
+             << endl;
+      }
+      if (CachedBrain::buildCacheSizePL->get(This_PT) > 0) {
+        cout << "    ..... brains built from genomes will be cached"
+             << endl;
+      }
+      if (CachedBrain::useCachePL->get(This_PT) ||
+          CachedBrain::buildCacheSizePL->get(This_PT) > 0) {
+        templateBrains[brainName] =
+            make_shared<CachedBrain>(templateBrains[brainName], This_PT);
+      }
       strSet = templateBrains[brainName]->requiredGenomes();
       if (strSet.size() > 0) {
         cout << "    ..... this brain requires genomes: ";
@@ -244,7 +262,7 @@ int main(int argc, const char *argv[]) {
     // make a organism with a templateGenomes and templateBrains - progenitor
     // serves as an ancestor to all and a template organism
     auto progenitor =
-        make_shared<Organism>(templateGenomes, templateBrains, PT);
+        OrganismPool::make(templateGenomes, templateBrains, PT);
 
 
     vector<shared_ptr<Organism>> population;
@@ -286,7 +304,7 @@ int main(int argc, const char *argv[]) {
         newBrains[brain.first] = brain.second->makeBrain(newGenomes);
       }
       auto newOrg =
-          make_shared<Organism>(progenitor, newGenomes, newBrains, PT);
+          OrganismPool::make(progenitor, move(newGenomes), move(newBrains), PT);
 
       // add new organism to population
       population.push_back(newOrg);